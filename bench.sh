@@ -0,0 +1,5 @@
+#! /bin/sh
+# Release build of the benchmarks, results written to build-bench/bench.json
+cmake -DBUILD_SHARED_LIBS=OFF -DGLM_BUILD_TESTS=OFF -DOpenGL_GL_PREFERENCE=GLVND -DCMAKE_BUILD_TYPE=Release -DSDL3_APP_BUILD_BENCH=ON -S . -B build-bench/
+cmake --build build-bench/ --target SDL3-App-Bench --parallel 10
+./build-bench/bin/SDL3-App-Bench --json build-bench/bench.json "$@"
@@ -0,0 +1,57 @@
+#include <vector>
+
+#include "bench.h"
+#include "game/freeListAllocator.h"
+
+// mesh sized requests: 8 to 64 vertices of a 20 byte layout.
+static unsigned int NextMeshSize(BenchRandom &random)
+{
+  return (8 + (random.Next() >> 16) % 57) * 20;
+}
+
+// Arg() meshes created and then freed, as when a level loads and unloads.
+static void FreeListAllocateFreeBench(BenchState &state)
+{
+  unsigned int meshes = (unsigned int)state.Arg();
+  FreeListAllocator allocator(meshes * 64 * 20);
+  std::vector<unsigned int> offsets(meshes), sizes(meshes);
+  while (state.KeepRunning())
+  {
+    BenchRandom random(7);
+    for (unsigned int i = 0; i < meshes; i++)
+    {
+      sizes[i] = NextMeshSize(random);
+      offsets[i] = allocator.Allocate(sizes[i], 20);
+    }
+    for (unsigned int i = 0; i < meshes; i++)
+      allocator.Free(offsets[i], sizes[i]);
+    DoNotOptimize(allocator);
+  }
+  state.SetItemsProcessed(state.Iterations() * meshes);
+}
+BENCHMARK("FreeListAllocator/AllocateFree", FreeListAllocateFreeBench, {1000, 10000});
+
+// steady state streaming: with Arg() meshes live, replace a random one each
+// step, which keeps the free list fragmented.
+static void FreeListChurnBench(BenchState &state)
+{
+  unsigned int meshes = (unsigned int)state.Arg();
+  FreeListAllocator allocator(meshes * 64 * 20 * 2);
+  std::vector<unsigned int> offsets(meshes), sizes(meshes);
+  BenchRandom random(11);
+  for (unsigned int i = 0; i < meshes; i++)
+  {
+    sizes[i] = NextMeshSize(random);
+    offsets[i] = allocator.Allocate(sizes[i], 20);
+  }
+  while (state.KeepRunning())
+  {
+    unsigned int victim = (random.Next() >> 8) % meshes;
+    allocator.Free(offsets[victim], sizes[victim]);
+    sizes[victim] = NextMeshSize(random);
+    offsets[victim] = allocator.Allocate(sizes[victim], 20);
+    DoNotOptimize(offsets[victim]);
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BENCHMARK("FreeListAllocator/Churn", FreeListChurnBench, {1000, 10000});
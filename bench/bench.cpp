@@ -0,0 +1,202 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+
+std::vector<BenchEntry> &GetBenchRegistry()
+{
+  static std::vector<BenchEntry> registry;
+  return registry;
+}
+
+struct BenchOptions
+{
+  std::string filter;
+  std::string jsonPath;
+  unsigned int warmupRuns = 1;
+  unsigned int samples = 10;
+  double minSampleMs = 20.0;
+};
+
+struct BenchResult
+{
+  std::string name;
+  int64_t arg;
+  bool hasArg;
+  uint64_t iterations;
+  double minNs, medianNs, meanNs, stddevNs;
+  double itemsPerMs;
+};
+
+static void PrintUsage(const char *exe)
+{
+  std::printf("Usage: %s [--filter <substring>] [--json <file>] [--warmup <runs>]"
+              " [--samples <count>] [--min-time <ms>] [--list]\n",
+              exe);
+}
+
+// runs a benchmark once with the given iteration count and returns ns/iteration.
+static double RunOnce(const BenchEntry &entry, int64_t arg, uint64_t iterations,
+                      uint64_t &itemsProcessed)
+{
+  BenchState state(iterations, arg);
+  entry.function(state);
+  itemsProcessed = state.GetItemsProcessed();
+  return state.GetElapsedNs() / (double)iterations;
+}
+
+static BenchResult RunBenchmark(const BenchEntry &entry, int64_t arg, bool hasArg,
+                                const BenchOptions &options)
+{
+  // grow the iteration count until one sample runs for at least minSampleMs.
+  uint64_t iterations = 1;
+  uint64_t items = 0;
+  while (true)
+  {
+    double perIter = RunOnce(entry, arg, iterations, items);
+    double sampleMs = perIter * (double)iterations / 1e6;
+    if (sampleMs >= options.minSampleMs || iterations >= (1ull << 30))
+      break;
+    double scale = sampleMs > 0.0 ? options.minSampleMs / sampleMs * 1.2 : 10.0;
+    iterations = (uint64_t)std::max(1.0, std::min(scale, 10.0) * (double)iterations);
+  }
+
+  for (unsigned int i = 0; i < options.warmupRuns; i++)
+    RunOnce(entry, arg, iterations, items);
+
+  std::vector<double> samples;
+  double itemsPerMsTotal = 0.0;
+  for (unsigned int i = 0; i < options.samples; i++)
+  {
+    double perIter = RunOnce(entry, arg, iterations, items);
+    samples.push_back(perIter);
+    if (items > 0)
+      itemsPerMsTotal += (double)items / (perIter * (double)iterations / 1e6);
+  }
+  std::sort(samples.begin(), samples.end());
+
+  BenchResult result{};
+  result.name = entry.name;
+  result.arg = arg;
+  result.hasArg = hasArg;
+  result.iterations = iterations;
+  result.minNs = samples.front();
+  result.medianNs = samples[samples.size() / 2];
+  double sum = 0.0;
+  for (double s : samples)
+    sum += s;
+  result.meanNs = sum / (double)samples.size();
+  double variance = 0.0;
+  for (double s : samples)
+    variance += (s - result.meanNs) * (s - result.meanNs);
+  result.stddevNs = std::sqrt(variance / (double)samples.size());
+  result.itemsPerMs = itemsPerMsTotal / (double)samples.size();
+  return result;
+}
+
+static std::string FullName(const BenchResult &result)
+{
+  if (!result.hasArg)
+    return result.name;
+  return result.name + "/" + std::to_string(result.arg);
+}
+
+static bool WriteJson(const std::string &path, const BenchOptions &options,
+                      const std::vector<BenchResult> &results)
+{
+  std::ofstream out(path);
+  if (!out)
+    return false;
+
+  out << "{\n  \"timestamp\": " << (long long)std::time(nullptr) << ",\n";
+  out << "  \"samples\": " << options.samples << ",\n";
+  out << "  \"warmup\": " << options.warmupRuns << ",\n";
+  out << "  \"benchmarks\": [\n";
+  for (size_t i = 0; i < results.size(); i++)
+  {
+    const BenchResult &r = results[i];
+    out << "    {\"name\": \"" << FullName(r) << "\", \"iterations\": " << r.iterations
+        << ", \"min_ns\": " << r.minNs << ", \"median_ns\": " << r.medianNs
+        << ", \"mean_ns\": " << r.meanNs << ", \"stddev_ns\": " << r.stddevNs
+        << ", \"items_per_ms\": " << r.itemsPerMs << "}"
+        << (i + 1 < results.size() ? ",\n" : "\n");
+  }
+  out << "  ]\n}\n";
+  return true;
+}
+
+int main(int argc, char *argv[])
+{
+  BenchOptions options;
+  bool listOnly = false;
+  for (int i = 1; i < argc; i++)
+  {
+    bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--filter") == 0 && hasValue)
+      options.filter = argv[++i];
+    else if (std::strcmp(argv[i], "--json") == 0 && hasValue)
+      options.jsonPath = argv[++i];
+    else if (std::strcmp(argv[i], "--warmup") == 0 && hasValue)
+      options.warmupRuns = (unsigned int)std::atoi(argv[++i]);
+    else if (std::strcmp(argv[i], "--samples") == 0 && hasValue)
+      options.samples = std::max(1, std::atoi(argv[++i]));
+    else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue)
+      options.minSampleMs = std::atof(argv[++i]);
+    else if (std::strcmp(argv[i], "--list") == 0)
+      listOnly = true;
+    else
+    {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  std::vector<BenchResult> results;
+  if (!listOnly)
+    std::printf("%-48s %14s %14s %14s %12s %14s\n", "Benchmark", "Min ns", "Median ns",
+                "Mean ns", "Stddev %", "Items/ms");
+  for (const BenchEntry &entry : GetBenchRegistry())
+  {
+    std::vector<int64_t> args = entry.args;
+    bool hasArg = !args.empty();
+    if (!hasArg)
+      args.push_back(0);
+
+    for (int64_t arg : args)
+    {
+      BenchResult probe{};
+      probe.name = entry.name;
+      probe.arg = arg;
+      probe.hasArg = hasArg;
+      std::string name = FullName(probe);
+      if (!options.filter.empty() && name.find(options.filter) == std::string::npos)
+        continue;
+      if (listOnly)
+      {
+        std::printf("%s\n", name.c_str());
+        continue;
+      }
+
+      BenchResult result = RunBenchmark(entry, arg, hasArg, options);
+      double stddevPct = result.meanNs > 0.0 ? result.stddevNs / result.meanNs * 100.0 : 0.0;
+      std::printf("%-48s %14.1f %14.1f %14.1f %11.2f%% %14.1f\n", name.c_str(), result.minNs,
+                  result.medianNs, result.meanNs, stddevPct, result.itemsPerMs);
+      std::fflush(stdout);
+      results.push_back(result);
+    }
+  }
+
+  if (!options.jsonPath.empty() && !WriteJson(options.jsonPath, options, results))
+  {
+    std::fprintf(stderr, "Failed to write %s\n", options.jsonPath.c_str());
+    return 1;
+  }
+  return 0;
+}
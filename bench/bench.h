@@ -0,0 +1,119 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Minimal microbenchmark harness for CPU side engine code.
+// Benchmarks are plain functions that loop on state.KeepRunning() and are
+// registered with the BENCHMARK macro, optionally once per argument value.
+
+class BenchState
+{
+private:
+  uint64_t m_iterations;
+  uint64_t m_remaining;
+  int64_t m_arg;
+  uint64_t m_itemsProcessed;
+  std::chrono::steady_clock::duration m_elapsed;
+  std::chrono::steady_clock::time_point m_start;
+  bool m_paused;
+
+public:
+  BenchState(uint64_t iterations, int64_t arg)
+      : m_iterations(iterations), m_remaining(iterations), m_arg(arg),
+        m_itemsProcessed(0), m_elapsed(0), m_paused(true) {}
+
+  // returns true while there are iterations left to time.
+  inline bool KeepRunning()
+  {
+    if (m_remaining == m_iterations && m_paused)
+      ResumeTiming();
+    if (m_remaining == 0)
+    {
+      PauseTiming();
+      return false;
+    }
+    m_remaining--;
+    return true;
+  }
+
+  // exclude setup work inside the loop from the measurement.
+  inline void PauseTiming()
+  {
+    if (m_paused)
+      return;
+    m_elapsed += std::chrono::steady_clock::now() - m_start;
+    m_paused = true;
+  }
+  inline void ResumeTiming()
+  {
+    if (!m_paused)
+      return;
+    m_start = std::chrono::steady_clock::now();
+    m_paused = false;
+  }
+
+  inline int64_t Arg() const { return m_arg; }
+  inline uint64_t Iterations() const { return m_iterations; }
+  // total items handled over all iterations, reported as items/ms.
+  inline void SetItemsProcessed(uint64_t items) { m_itemsProcessed = items; }
+  inline uint64_t GetItemsProcessed() const { return m_itemsProcessed; }
+  inline double GetElapsedNs() const
+  {
+    return std::chrono::duration<double, std::nano>(m_elapsed).count();
+  }
+};
+
+using BenchFunction = std::function<void(BenchState &)>;
+
+struct BenchEntry
+{
+  std::string name;
+  BenchFunction function;
+  std::vector<int64_t> args;
+};
+
+std::vector<BenchEntry> &GetBenchRegistry();
+
+struct BenchRegistrar
+{
+  BenchRegistrar(const char *name, BenchFunction function,
+                 std::vector<int64_t> args = {})
+  {
+    GetBenchRegistry().push_back({name, std::move(function), std::move(args)});
+  }
+};
+
+// seeded linear congruential generator for benchmark data, the same seed
+// gives the same data on every run so results stay comparable.
+class BenchRandom
+{
+private:
+  uint32_t m_state;
+
+public:
+  explicit BenchRandom(uint32_t seed) : m_state(seed) {}
+
+  // advances and returns the full 32 bit state, the high bits are the most random.
+  inline uint32_t Next()
+  {
+    m_state = m_state * 1664525u + 1013904223u;
+    return m_state;
+  }
+};
+
+// keeps the compiler from optimizing away a value that is otherwise unused.
+template <typename T>
+inline void DoNotOptimize(T const &value)
+{
+  __asm__ volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void ClobberMemory() { __asm__ volatile("" : : : "memory"); }
+
+#define BENCH_CONCAT_IMPL(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_IMPL(a, b)
+#define BENCHMARK(name, function, ...) \
+  static BenchRegistrar BENCH_CONCAT(s_benchRegistrar, __LINE__)(name, function, ##__VA_ARGS__)
@@ -0,0 +1,30 @@
+#include "bench.h"
+#include "game/vertexBufferLayout.h"
+
+// the position + texcoord layout built in Game::Run.
+static void VertexBufferLayoutBench(BenchState &state)
+{
+  while (state.KeepRunning())
+  {
+    VertexBufferLayout layout;
+    layout.Push<float>(3);
+    layout.Push<float>(2);
+    DoNotOptimize(layout.GetStride());
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BENCHMARK("VertexBufferLayout/Construct", VertexBufferLayoutBench);
+
+static void VertexBufferLayoutElementsBench(BenchState &state)
+{
+  VertexBufferLayout layout;
+  layout.Push<float>(3);
+  layout.Push<float>(2);
+  while (state.KeepRunning())
+  {
+    const auto &elements = layout.GetElements();
+    DoNotOptimize(elements.data());
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BENCHMARK("VertexBufferLayout/GetElements", VertexBufferLayoutElementsBench);
@@ -0,0 +1,82 @@
+#include <SDL3/SDL.h>
+#include <cstdio>
+
+#include "bench.h"
+#include "game/log.h"
+
+static void DiscardLogOutput(void *, int, SDL_LogPriority, const char *) {}
+
+// keeps log output off the benchmark table while the writer thread runs.
+struct QuietLog
+{
+  SDL_LogOutputFunction previous;
+  void *previousData;
+
+  QuietLog()
+  {
+    SDL_GetLogOutputFunction(&previous, &previousData);
+    SDL_SetLogOutputFunction(DiscardLogOutput, nullptr);
+    Log::Init();
+  }
+  ~QuietLog()
+  {
+    Log::Shutdown();
+    SDL_SetLogOutputFunction(previous, previousData);
+  }
+};
+
+// half of the 1024 records a thread's ring holds, so a batch never fills it.
+static constexpr int LogQueueBatch = 512;
+
+// cost on the calling thread, formatting happens on the writer thread. The
+// ring is drained untimed between batches so only the enqueue is measured,
+// not the drop path of a full buffer.
+static void LogQueueBench(BenchState &state)
+{
+  QuietLog quiet;
+  Log::Flush();
+  unsigned long long droppedBefore = Log::GetDroppedCount();
+  int frame = 0;
+  while (state.KeepRunning())
+  {
+    Log::Write(LogLevel::Info, LogCategory::App, "frame %d took %f ms in %s", frame++, 16.6f, "Game::Run");
+    if (frame % LogQueueBatch == 0)
+    {
+      state.PauseTiming();
+      Log::Flush();
+      state.ResumeTiming();
+    }
+  }
+  Log::Flush();
+  unsigned long long dropped = Log::GetDroppedCount() - droppedBefore;
+  if (dropped > 0)
+    std::fprintf(stderr, "Log/Queue: %llu of %llu records dropped, result includes the drop path\n",
+                 dropped, (unsigned long long)state.Iterations());
+  state.SetItemsProcessed(state.Iterations() - dropped);
+}
+BENCHMARK("Log/Queue", LogQueueBench);
+
+// what every message cost before, without the write to stdout.
+static void LogFormatInlineBench(BenchState &state)
+{
+  char message[1024];
+  int frame = 0;
+  while (state.KeepRunning())
+  {
+    SDL_snprintf(message, sizeof(message), "frame %d took %f ms in %s", frame++, 16.6f, "Game::Run");
+    DoNotOptimize(message);
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BENCHMARK("Log/FormatInline", LogFormatInlineBench);
+
+static void LogFilteredBench(BenchState &state)
+{
+  Log::SetLevel(LogCategory::Render, LogLevel::Warn);
+  int frame = 0;
+  while (state.KeepRunning())
+    LOG_INFO(LogCategory::Render, "frame %d", frame++);
+  Log::SetLevel(LogCategory::Render, LogLevel::Trace);
+  state.SetItemsProcessed(state.Iterations());
+}
+BENCHMARK("Log/FilteredOut", LogFilteredBench);
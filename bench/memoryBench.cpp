@@ -0,0 +1,129 @@
+#include <cstring>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "bench.h"
+#include "game/arenaAllocator.h"
+#include "game/linearArena.h"
+#include "game/poolAllocator.h"
+
+struct ScratchItem
+{
+  float values[6];
+};
+
+// Arg() small transient objects per frame from the heap, the baseline.
+static void HeapScratchBench(BenchState &state)
+{
+  int64_t count = state.Arg();
+  std::vector<ScratchItem *> items((size_t)count);
+  while (state.KeepRunning())
+  {
+    for (int64_t i = 0; i < count; i++)
+      items[i] = new ScratchItem();
+    DoNotOptimize(items.data());
+    for (int64_t i = 0; i < count; i++)
+      delete items[i];
+  }
+  state.SetItemsProcessed(state.Iterations() * (uint64_t)count);
+}
+BENCHMARK("Memory/HeapScratch", HeapScratchBench, {100, 10000});
+
+// the same objects from the frame arena, freed all at once by EndFrame.
+static void FrameArenaScratchBench(BenchState &state)
+{
+  int64_t count = state.Arg();
+  FrameAllocator frameMemory(1 << 20);
+  std::vector<ScratchItem *> items((size_t)count);
+  while (state.KeepRunning())
+  {
+    for (int64_t i = 0; i < count; i++)
+      items[i] = new (frameMemory.Allocate(sizeof(ScratchItem), alignof(ScratchItem))) ScratchItem();
+    DoNotOptimize(items.data());
+    frameMemory.EndFrame();
+  }
+  state.SetItemsProcessed(state.Iterations() * (uint64_t)count);
+}
+BENCHMARK("Memory/FrameArenaScratch", FrameArenaScratchBench, {100, 10000});
+
+static void BlockPoolScratchBench(BenchState &state)
+{
+  int64_t count = state.Arg();
+  BlockPool pool(sizeof(ScratchItem));
+  std::vector<ScratchItem *> items((size_t)count);
+  while (state.KeepRunning())
+  {
+    for (int64_t i = 0; i < count; i++)
+      items[i] = new (pool.Allocate()) ScratchItem();
+    DoNotOptimize(items.data());
+    for (int64_t i = 0; i < count; i++)
+      pool.Free(items[i]);
+  }
+  state.SetItemsProcessed(state.Iterations() * (uint64_t)count);
+}
+BENCHMARK("Memory/BlockPoolScratch", BlockPoolScratchBench, {100, 10000});
+
+// a per frame command list grown element by element.
+static void HeapVectorBench(BenchState &state)
+{
+  int64_t count = state.Arg();
+  while (state.KeepRunning())
+  {
+    std::vector<ScratchItem> commands;
+    for (int64_t i = 0; i < count; i++)
+      commands.push_back(ScratchItem());
+    DoNotOptimize(commands.data());
+  }
+  state.SetItemsProcessed(state.Iterations() * (uint64_t)count);
+}
+BENCHMARK("Memory/HeapVector", HeapVectorBench, {100, 10000});
+
+static void ArenaVectorBench(BenchState &state)
+{
+  int64_t count = state.Arg();
+  FrameAllocator frameMemory(1 << 20);
+  while (state.KeepRunning())
+  {
+    {
+      ArenaVector<ScratchItem> commands(ArenaAllocator<ScratchItem>(&frameMemory.GetArena()));
+      for (int64_t i = 0; i < count; i++)
+        commands.push_back(ScratchItem());
+      DoNotOptimize(commands.data());
+    }
+    frameMemory.EndFrame();
+  }
+  state.SetItemsProcessed(state.Iterations() * (uint64_t)count);
+}
+BENCHMARK("Memory/ArenaVector", ArenaVectorBench, {100, 10000});
+
+// map insert and erase, as in the free lists of FreeListAllocator.
+static void HeapMapBench(BenchState &state)
+{
+  int64_t count = state.Arg();
+  std::map<unsigned int, unsigned int> map;
+  while (state.KeepRunning())
+  {
+    for (int64_t i = 0; i < count; i++)
+      map.emplace((unsigned int)(i * 2654435761u), (unsigned int)i);
+    map.clear();
+  }
+  state.SetItemsProcessed(state.Iterations() * (uint64_t)count);
+}
+BENCHMARK("Memory/HeapMap", HeapMapBench, {100, 10000});
+
+static void PoolMapBench(BenchState &state)
+{
+  using Node = std::pair<const unsigned int, unsigned int>;
+  int64_t count = state.Arg();
+  BlockPool pool(64);
+  std::map<unsigned int, unsigned int, std::less<unsigned int>, PoolAllocator<Node>> map{PoolAllocator<Node>(&pool)};
+  while (state.KeepRunning())
+  {
+    for (int64_t i = 0; i < count; i++)
+      map.emplace((unsigned int)(i * 2654435761u), (unsigned int)i);
+    map.clear();
+  }
+  state.SetItemsProcessed(state.Iterations() * (uint64_t)count);
+}
+BENCHMARK("Memory/PoolMap", PoolMapBench, {100, 10000});
@@ -0,0 +1,146 @@
+#include <vector>
+
+#include "bench.h"
+#include "game/flowField.h"
+#include "game/hierarchicalPathfinder.h"
+#include "game/navGrid.h"
+#include "game/threadPool.h"
+
+// Arg() x Arg() grid with ~20% of tiles blocked and some rough terrain.
+static void FillGrid(NavGrid &grid)
+{
+  BenchRandom random(12345);
+  for (int y = 0; y < grid.GetHeight(); y++)
+  {
+    for (int x = 0; x < grid.GetWidth(); x++)
+    {
+      unsigned int roll = (random.Next() >> 16) % 100;
+      if (roll < 20)
+        grid.SetCost(x, y, NavGrid::Blocked);
+      else if (roll < 30)
+        grid.SetCost(x, y, 4);
+    }
+  }
+  // keep the corners used as goals and starts open.
+  grid.SetCost(0, 0, 1);
+  grid.SetCost(grid.GetWidth() - 1, grid.GetHeight() - 1, 1);
+  grid.SetCost(grid.GetWidth() / 2, grid.GetHeight() / 2, 1);
+  grid.ClearChanges();
+}
+
+static ThreadPool &GetPool()
+{
+  static ThreadPool pool;
+  return pool;
+}
+
+static void FlowFieldBuildBench(BenchState &state)
+{
+  int size = (int)state.Arg();
+  NavGrid grid(size, size);
+  FillGrid(grid);
+  FlowField field(grid, {size / 2, size / 2});
+  while (state.KeepRunning())
+    field.Build();
+  state.SetItemsProcessed(state.Iterations() * grid.GetCellCount());
+}
+BENCHMARK("FlowField/Build", FlowFieldBuildBench, {256, 1024});
+
+// toggles a small wall near the goal each iteration and repairs the field.
+static void FlowFieldUpdateBench(BenchState &state)
+{
+  int size = (int)state.Arg();
+  NavGrid grid(size, size);
+  FillGrid(grid);
+  FlowField field(grid, {size / 2, size / 2});
+  field.Build();
+  bool blocked = false;
+  while (state.KeepRunning())
+  {
+    state.PauseTiming();
+    blocked = !blocked;
+    for (int i = 0; i < 8; i++)
+      grid.SetCost(size / 2 + 4 + i, size / 2 + 6, blocked ? NavGrid::Blocked : 1);
+    state.ResumeTiming();
+    field.Update(grid.GetChangedCells());
+    grid.ClearChanges();
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BENCHMARK("FlowField/IncrementalUpdate", FlowFieldUpdateBench, {256, 1024});
+
+// per agent direction lookups, Arg() agents spread over a 256 grid.
+static void FlowFieldLookupBench(BenchState &state)
+{
+  int64_t agents = state.Arg();
+  NavGrid grid(256, 256);
+  FillGrid(grid);
+  FlowField field(grid, {128, 128});
+  field.Build();
+  std::vector<GridCell> positions((size_t)agents);
+  BenchRandom random(99);
+  for (GridCell &position : positions)
+  {
+    unsigned int seed = random.Next();
+    position = {(int)((seed >> 8) % 256), (int)((seed >> 20) % 256)};
+  }
+  while (state.KeepRunning())
+  {
+    for (const GridCell &position : positions)
+    {
+      glm::vec2 direction = field.GetDirection(position.x, position.y);
+      DoNotOptimize(direction);
+    }
+  }
+  state.SetItemsProcessed(state.Iterations() * (uint64_t)agents);
+}
+BENCHMARK("FlowField/Lookup", FlowFieldLookupBench, {1000, 100000});
+
+// 8 goals built at once through the thread pool.
+static void FlowFieldCachePrepareBench(BenchState &state)
+{
+  int size = (int)state.Arg();
+  NavGrid grid(size, size);
+  FillGrid(grid);
+  std::vector<GridCell> goals;
+  for (int i = 0; i < 8; i++)
+    goals.push_back({(i * 37) % size, (i * 53) % size});
+  while (state.KeepRunning())
+  {
+    FlowFieldCache cache(grid, 8, &GetPool());
+    cache.Prepare(goals);
+    DoNotOptimize(cache);
+  }
+  state.SetItemsProcessed(state.Iterations() * goals.size());
+}
+BENCHMARK("FlowFieldCache/Prepare8", FlowFieldCachePrepareBench, {256, 1024});
+
+static void HierarchicalBuildBench(BenchState &state)
+{
+  int size = (int)state.Arg();
+  NavGrid grid(size, size);
+  FillGrid(grid);
+  HierarchicalPathfinder pathfinder(grid);
+  while (state.KeepRunning())
+    pathfinder.Build(&GetPool());
+  state.SetItemsProcessed(state.Iterations() * grid.GetCellCount());
+}
+BENCHMARK("HierarchicalPathfinder/Build", HierarchicalBuildBench, {256, 1024});
+
+// corner to corner, the case a single flow field is overkill for.
+static void HierarchicalFindPathBench(BenchState &state)
+{
+  int size = (int)state.Arg();
+  NavGrid grid(size, size);
+  FillGrid(grid);
+  HierarchicalPathfinder pathfinder(grid);
+  pathfinder.Build(&GetPool());
+  std::vector<GridCell> path;
+  while (state.KeepRunning())
+  {
+    bool found = pathfinder.FindPath({0, 0}, {size - 1, size - 1}, path);
+    DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BENCHMARK("HierarchicalPathfinder/FindPath", HierarchicalFindPathBench, {256, 1024});
@@ -0,0 +1,54 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "bench.h"
+#include "game/shader.h"
+
+// builds a shader file with the given number of lines per stage, shaped like
+// data/res/Basic.shader.
+static std::string MakeShaderSource(int64_t linesPerStage)
+{
+  std::string source;
+  const char *stages[] = {"vertex", "fragment"};
+  for (const char *stage : stages)
+  {
+    source += "#shader ";
+    source += stage;
+    source += "\n#version 420 core\n";
+    for (int64_t i = 0; i < linesPerStage; i++)
+      source += "uniform vec4 u_Value" + std::to_string(i) + "; // padding comment\n";
+    source += "void main()\n{\n}\n";
+  }
+  return source;
+}
+
+static void ParseShaderBench(BenchState &state)
+{
+  std::string source = MakeShaderSource(state.Arg());
+  while (state.KeepRunning())
+  {
+    std::istringstream stream(source);
+    ShaderProgramSource parsed = Shader::ParseShaderSource(stream);
+    DoNotOptimize(parsed.VertexSource.data());
+    DoNotOptimize(parsed.FragmentSource.data());
+  }
+  state.SetItemsProcessed(state.Iterations() * 2 * (uint64_t)state.Arg());
+}
+BENCHMARK("Shader/ParseShader", ParseShaderBench, {100, 1000, 10000});
+
+static void BuildVariantSourceBench(BenchState &state)
+{
+  std::istringstream stream(MakeShaderSource(state.Arg()));
+  ShaderProgramSource parsed = Shader::ParseShaderSource(stream);
+  std::vector<std::string> defines = {"USE_TINT", "MAX_LIGHTS=4", "USE_SHADOWS"};
+  while (state.KeepRunning())
+  {
+    std::string vertex = Shader::BuildVariantSource(parsed.VertexSource, defines);
+    std::string fragment = Shader::BuildVariantSource(parsed.FragmentSource, defines);
+    DoNotOptimize(vertex.data());
+    DoNotOptimize(fragment.data());
+  }
+  state.SetItemsProcessed(state.Iterations() * 2);
+}
+BENCHMARK("Shader/BuildVariantSource", BuildVariantSourceBench, {100, 1000, 10000});
@@ -0,0 +1,48 @@
+#include <SDL3/SDL.h>
+
+#include "bench.h"
+#include "game/texture.h"
+
+static SDL_Surface *MakeSurface(int size, SDL_PixelFormat format)
+{
+  SDL_Surface *surface = SDL_CreateSurface(size, size, format);
+  Uint8 *pixels = (Uint8 *)surface->pixels;
+  for (int i = 0; i < surface->pitch * surface->h; i++)
+    pixels[i] = (Uint8)(i * 31);
+  return surface;
+}
+
+static void FlipSurfaceBench(BenchState &state)
+{
+  int size = (int)state.Arg();
+  SDL_Surface *surface = MakeSurface(size, SDL_PIXELFORMAT_RGBA32);
+  while (state.KeepRunning())
+  {
+    SDL_Surface *flipped = Texture::FlipSurface(surface);
+    DoNotOptimize(flipped);
+    state.PauseTiming();
+    SDL_DestroySurface(flipped);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.Iterations() * (uint64_t)size * (uint64_t)size);
+  SDL_DestroySurface(surface);
+}
+BENCHMARK("Texture/FlipSurface", FlipSurfaceBench, {64, 256, 1024, 4096});
+
+// the conversion Texture does on load, from a typical image format to RGBA32.
+static void ConvertSurfaceBench(BenchState &state)
+{
+  int size = (int)state.Arg();
+  SDL_Surface *surface = MakeSurface(size, SDL_PIXELFORMAT_ARGB8888);
+  while (state.KeepRunning())
+  {
+    SDL_Surface *converted = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
+    DoNotOptimize(converted);
+    state.PauseTiming();
+    SDL_DestroySurface(converted);
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.Iterations() * (uint64_t)size * (uint64_t)size);
+  SDL_DestroySurface(surface);
+}
+BENCHMARK("Texture/ConvertSurface", ConvertSurfaceBench, {64, 256, 1024, 4096});
@@ -0,0 +1,177 @@
+#include <vector>
+
+#include "bench.h"
+#include "game/tilemap.h"
+
+// 4096 x 4096 tiles of 16 units: a filled ground layer and a sparse detail layer.
+static constexpr int MapSize = 4096;
+static constexpr float TileSize = 16.0f;
+
+static Tilemap &GetMap()
+{
+  static Tilemap *map = nullptr;
+  if (!map)
+  {
+    map = new Tilemap(MapSize, MapSize, 2, TileSize, 16, 16);
+    BenchRandom random(2024);
+    for (int y = 0; y < MapSize; y++)
+    {
+      for (int x = 0; x < MapSize; x++)
+      {
+        unsigned int seed = random.Next();
+        map->SetTile(0, x, y, (unsigned short)(1 + (seed >> 16) % 64));
+        if ((seed >> 8) % 8 == 0)
+          map->SetTile(1, x, y, (unsigned short)(65 + (seed >> 20) % 32));
+      }
+    }
+    map->AddAnimation(65, 4, 0.25f);
+  }
+  return *map;
+}
+
+// a 1280 x 720 view somewhere on the map.
+static void RandomView(BenchRandom &random, glm::vec2 &min, glm::vec2 &max)
+{
+  float world = MapSize * TileSize;
+  unsigned int seed = random.Next();
+  min = glm::vec2((float)((seed >> 8) % (unsigned int)(world - 1280.0f)),
+                  (float)((seed >> 4) % (unsigned int)(world - 720.0f)));
+  max = min + glm::vec2(1280.0f, 720.0f);
+}
+
+static void BuildChunkBench(BenchState &state)
+{
+  Tilemap &map = GetMap();
+  int layer = (int)state.Arg();
+  std::vector<TileVertex> vertices(Tilemap::ChunkTiles * 4);
+  int chunk = 0, chunkCount = map.GetChunksX() * map.GetChunksY();
+  uint64_t tiles = 0;
+  while (state.KeepRunning())
+  {
+    tiles += map.BuildChunkVertices(layer, chunk % map.GetChunksX(), chunk / map.GetChunksX(), vertices.data());
+    chunk = (chunk + 1) % chunkCount;
+    DoNotOptimize(vertices.data());
+  }
+  state.SetItemsProcessed(tiles);
+}
+BENCHMARK("Tilemap/BuildChunkVertices", BuildChunkBench, {0, 1});
+
+// what the renderer does each frame for a view without changes: find the
+// visible chunks and check their versions, nothing is rebuilt.
+static void CullViewBench(BenchState &state)
+{
+  Tilemap &map = GetMap();
+  std::vector<unsigned int> builtVersions((size_t)map.GetLayerCount() * map.GetChunksX() * map.GetChunksY(), 0);
+  BenchRandom random(1);
+  uint64_t chunks = 0;
+  while (state.KeepRunning())
+  {
+    glm::vec2 min, max;
+    RandomView(random, min, max);
+    int x0, y0, x1, y1;
+    map.GetVisibleChunks(min, max, x0, y0, x1, y1);
+    unsigned int stale = 0;
+    for (int layer = 0; layer < map.GetLayerCount(); layer++)
+    {
+      for (int y = y0; y < y1; y++)
+      {
+        for (int x = x0; x < x1; x++)
+          stale += builtVersions[map.ChunkIndex(layer, x, y)] != map.GetChunkVersion(layer, x, y);
+      }
+    }
+    chunks += (uint64_t)map.GetLayerCount() * (x1 - x0) * (y1 - y0);
+    DoNotOptimize(stale);
+  }
+  state.SetItemsProcessed(chunks);
+}
+BENCHMARK("Tilemap/CullView", CullViewBench);
+
+// the per frame alternative chunking replaces: rebuilding every visible
+// tile's quad every frame.
+static void RebuildVisibleEveryFrameBench(BenchState &state)
+{
+  Tilemap &map = GetMap();
+  std::vector<TileVertex> vertices(Tilemap::ChunkTiles * 4);
+  BenchRandom random(1);
+  uint64_t tiles = 0;
+  while (state.KeepRunning())
+  {
+    glm::vec2 min, max;
+    RandomView(random, min, max);
+    int x0, y0, x1, y1;
+    map.GetVisibleChunks(min, max, x0, y0, x1, y1);
+    for (int layer = 0; layer < map.GetLayerCount(); layer++)
+    {
+      for (int y = y0; y < y1; y++)
+      {
+        for (int x = x0; x < x1; x++)
+          tiles += map.BuildChunkVertices(layer, x, y, vertices.data());
+      }
+    }
+    DoNotOptimize(vertices.data());
+  }
+  state.SetItemsProcessed(tiles);
+}
+BENCHMARK("Tilemap/RebuildVisibleEveryFrame", RebuildVisibleEveryFrameBench);
+
+// Arg() tile edits inside a fixed view per frame, then only the chunks they
+// dirtied are rebuilt. The edited tiles are put back afterwards so the shared
+// map is the same for every run.
+static void EditAndRebuildDirtyBench(BenchState &state)
+{
+  Tilemap &map = GetMap();
+  int edits = (int)state.Arg();
+  std::vector<unsigned int> builtVersions((size_t)map.GetLayerCount() * map.GetChunksX() * map.GetChunksY(), 0);
+  std::vector<TileVertex> vertices(Tilemap::ChunkTiles * 4);
+  glm::vec2 min(20000.0f, 20000.0f), max = min + glm::vec2(1280.0f, 720.0f);
+  int x0, y0, x1, y1;
+  map.GetVisibleChunks(min, max, x0, y0, x1, y1);
+  for (int y = y0; y < y1; y++)
+  {
+    for (int x = x0; x < x1; x++)
+      builtVersions[map.ChunkIndex(0, x, y)] = map.GetChunkVersion(0, x, y);
+  }
+
+  // the view is 80 x 45 tiles.
+  constexpr int EditWidth = 80, EditHeight = 45;
+  int editX = (int)(min.x / TileSize), editY = (int)(min.y / TileSize);
+  std::vector<unsigned short> original(EditWidth * EditHeight);
+  for (int y = 0; y < EditHeight; y++)
+  {
+    for (int x = 0; x < EditWidth; x++)
+      original[y * EditWidth + x] = map.GetTile(0, editX + x, editY + y);
+  }
+
+  BenchRandom random(5);
+  uint64_t rebuilt = 0;
+  while (state.KeepRunning())
+  {
+    for (int i = 0; i < edits; i++)
+    {
+      unsigned int seed = random.Next();
+      int tx = editX + (int)((seed >> 8) % EditWidth);
+      int ty = editY + (int)((seed >> 18) % EditHeight);
+      map.SetTile(0, tx, ty, (unsigned short)(1 + (seed >> 4) % 64));
+    }
+    for (int y = y0; y < y1; y++)
+    {
+      for (int x = x0; x < x1; x++)
+      {
+        unsigned int &built = builtVersions[map.ChunkIndex(0, x, y)];
+        if (built == map.GetChunkVersion(0, x, y))
+          continue;
+        map.BuildChunkVertices(0, x, y, vertices.data());
+        built = map.GetChunkVersion(0, x, y);
+        rebuilt++;
+      }
+    }
+    DoNotOptimize(vertices.data());
+  }
+  for (int y = 0; y < EditHeight; y++)
+  {
+    for (int x = 0; x < EditWidth; x++)
+      map.SetTile(0, editX + x, editY + y, original[y * EditWidth + x]);
+  }
+  state.SetItemsProcessed(rebuilt);
+}
+BENCHMARK("Tilemap/EditAndRebuildDirty", EditAndRebuildDirtyBench, {1, 16});
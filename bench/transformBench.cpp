@@ -0,0 +1,103 @@
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "bench.h"
+#include "game/camera.h"
+#include "game/threadPool.h"
+#include "game/transformHierarchy.h"
+
+// mirrors the per frame matrix building in Game::Run, for Arg() objects.
+static void BuildMvpBench(BenchState &state)
+{
+  int64_t objects = state.Arg();
+  glm::vec3 cameraPos(0.0f, -0.5f, -2.0f);
+  int gameWidth = 640, gameHeight = 360;
+  float rotation = 0.0f;
+  while (state.KeepRunning())
+  {
+    for (int64_t i = 0; i < objects; i++)
+    {
+      rotation -= 0.05f;
+      glm::mat4 model = glm::mat4(1.0f);
+      glm::mat4 view = glm::mat4(1.0f);
+      glm::mat4 proj = glm::mat4(1.0f);
+      model = glm::rotate(model, glm::radians(rotation), glm::vec3(0.0f, 1.0f, 0.0f));
+      view = glm::translate(view, cameraPos);
+      proj = glm::perspective(glm::radians(45.0f), (float)gameWidth / (float)gameHeight, 0.1f, 100.0f);
+      glm::mat4 mvp = proj * view * model;
+      DoNotOptimize(mvp);
+    }
+  }
+  state.SetItemsProcessed(state.Iterations() * (uint64_t)objects);
+}
+BENCHMARK("Transform/BuildMVP", BuildMvpBench, {1, 1000, 100000});
+
+static void CameraViewProjectionBench(BenchState &state)
+{
+  Camera camera(45.0f, 1280, 720, 0.1f, 100.0f);
+  camera.SetPosition(glm::vec3(0.0f, -0.5f, -2.0f));
+  while (state.KeepRunning())
+  {
+    glm::mat4 mvp = camera.GetViewProjection();
+    DoNotOptimize(mvp);
+  }
+  state.SetItemsProcessed(state.Iterations());
+}
+BENCHMARK("Transform/CameraCachedViewProjection", CameraViewProjectionBench);
+
+// a forest of shallow trees: roots with 8 children, each with 8 leaves.
+static constexpr unsigned int TreeSize = 1 + 8 + 8 * 8;
+
+static void BuildHierarchy(TransformHierarchy &scene, unsigned int nodes)
+{
+  while (scene.GetCount() < nodes)
+  {
+    unsigned int root = scene.Add(TransformHierarchy::NoParent, glm::vec3((float)scene.GetCount(), 0.0f, 0.0f));
+    for (int i = 0; i < 8 && scene.GetCount() < nodes; i++)
+    {
+      unsigned int child = scene.Add(root, glm::vec3(1.0f, 0.0f, 0.0f));
+      for (int j = 0; j < 8 && scene.GetCount() < nodes; j++)
+        scene.Add(child, glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+  }
+  scene.Update();
+}
+
+// every root moves each frame, so the whole hierarchy is rebuilt.
+static void HierarchyUpdate(BenchState &state, ThreadPool *pool, unsigned int dirtyStride)
+{
+  TransformHierarchy scene;
+  BuildHierarchy(scene, (unsigned int)state.Arg());
+  uint64_t updated = 0;
+  float angle = 0.0f;
+  while (state.KeepRunning())
+  {
+    angle += 0.01f;
+    glm::quat rotation = glm::angleAxis(angle, glm::vec3(0.0f, 1.0f, 0.0f));
+    for (unsigned int node = 0; node < scene.GetCount(); node += dirtyStride)
+      scene.SetRotation(node, rotation);
+    updated += scene.Update(pool);
+  }
+  state.SetItemsProcessed(updated);
+}
+
+static void HierarchyUpdateAllBench(BenchState &state)
+{
+  HierarchyUpdate(state, nullptr, TreeSize);
+}
+BENCHMARK("TransformHierarchy/UpdateAll", HierarchyUpdateAllBench, {1000, 100000, 1000000});
+
+static void HierarchyUpdateAllParallelBench(BenchState &state)
+{
+  static ThreadPool pool;
+  HierarchyUpdate(state, &pool, TreeSize);
+}
+BENCHMARK("TransformHierarchy/UpdateAllParallel", HierarchyUpdateAllParallelBench, {1000, 100000, 1000000});
+
+// only one node in ~1000 changes, most of the hierarchy is skipped.
+static void HierarchyUpdateSparseBench(BenchState &state)
+{
+  HierarchyUpdate(state, nullptr, 1009);
+}
+BENCHMARK("TransformHierarchy/UpdateSparse", HierarchyUpdateSparseBench, {1000, 100000, 1000000});
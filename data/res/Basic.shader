@@ -1,3 +1,5 @@
+#variant tinted USE_TINT
+
 #shader vertex
 #version 420 core
   
@@ -28,5 +30,8 @@ void main()
 {
 	vec4 texColor = texture(u_Texture, v_TexCoord);
 	color = texColor;
+#ifdef USE_TINT
+	color *= u_Color;
+#endif
 	//color = vec4(1.0,0.0,0.0,1.0);
 };
\ No newline at end of file
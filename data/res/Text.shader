@@ -0,0 +1,38 @@
+#shader vertex
+#version 420 core
+
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 texCoord;
+layout(location = 2) in vec4 color;
+
+out vec2 v_TexCoord;
+out vec4 v_Color;
+
+uniform mat4 u_Projection;
+
+void main()
+{
+	gl_Position = u_Projection * vec4(position, 0.0, 1.0);
+	v_TexCoord = texCoord;
+	v_Color = color;
+};
+
+#shader fragment
+#version 420 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+in vec4 v_Color;
+
+uniform sampler2D u_Atlas;
+
+void main()
+{
+	// 0.5 is the glyph edge, fwidth keeps the edge one screen pixel wide at
+	// any scale so upscaled text stays sharp.
+	float distance = texture(u_Atlas, v_TexCoord).r;
+	float width = max(fwidth(distance), 0.0001);
+	float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+	color = vec4(v_Color.rgb, v_Color.a * alpha);
+};
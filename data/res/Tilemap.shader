@@ -0,0 +1,32 @@
+#shader vertex
+#version 420 core
+
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec2 texCoord;
+layout(location = 2) in float animation;
+
+out vec2 v_TexCoord;
+
+uniform mat4 u_ViewProjection;
+// uv offset of the current frame per animation slot, slot 0 stays zero.
+uniform vec2 u_AnimationOffsets[16];
+
+void main()
+{
+	gl_Position = u_ViewProjection * vec4(position, 0.0, 1.0);
+	v_TexCoord = texCoord + u_AnimationOffsets[int(animation)];
+};
+
+#shader fragment
+#version 420 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_TexCoord;
+
+uniform sampler2D u_Tileset;
+
+void main()
+{
+	color = texture(u_Tileset, v_TexCoord);
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+#include "linearArena.h"
+
+// STL allocator drawing from a LinearArena. deallocate does nothing, memory
+// comes back when the arena is reset, so containers using it must not
+// outlive that (for the frame arena: the end of the next frame).
+template <typename T>
+class ArenaAllocator
+{
+private:
+  LinearArena *m_arena;
+
+  template <typename U>
+  friend class ArenaAllocator;
+
+public:
+  using value_type = T;
+
+  ArenaAllocator(LinearArena *arena) : m_arena(arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U> &other) : m_arena(other.m_arena) {}
+
+  T *allocate(size_t count) { return m_arena->AllocateArray<T>(count); }
+  void deallocate(T *, size_t) {}
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U> &other) const { return m_arena == other.m_arena; }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U> &other) const { return m_arena != other.m_arena; }
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
@@ -0,0 +1,45 @@
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "camera.h"
+
+Camera::Camera(float fovDegrees, int viewportWidth, int viewportHeight, float nearPlane, float farPlane)
+    : m_position(0.0f), m_fov(glm::radians(fovDegrees)), m_aspect(1.0f), m_near(nearPlane),
+      m_far(farPlane), m_view(1.0f), m_projection(1.0f), m_viewProjection(1.0f),
+      m_viewDirty(true), m_projectionDirty(true)
+{
+  SetViewport(viewportWidth, viewportHeight);
+}
+
+void Camera::SetPosition(const glm::vec3 &position)
+{
+  if (m_position == position)
+    return;
+  m_position = position;
+  m_viewDirty = true;
+}
+
+void Camera::SetViewport(int width, int height)
+{
+  if (width <= 0 || height <= 0)
+    return;
+  float aspect = (float)width / (float)height;
+  if (aspect == m_aspect && !m_projectionDirty)
+    return;
+  m_aspect = aspect;
+  m_projectionDirty = true;
+}
+
+const glm::mat4 &Camera::GetViewProjection()
+{
+  if (!m_viewDirty && !m_projectionDirty)
+    return m_viewProjection;
+
+  if (m_viewDirty)
+    m_view = glm::translate(glm::mat4(1.0f), m_position);
+  if (m_projectionDirty)
+    m_projection = glm::perspective(m_fov, m_aspect, m_near, m_far);
+  m_viewProjection = m_projection * m_view;
+  m_viewDirty = false;
+  m_projectionDirty = false;
+  return m_viewProjection;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <glm/glm.hpp>
+
+// Perspective camera that keeps its view, projection and view-projection
+// matrices cached until the position or the viewport changes.
+class Camera
+{
+private:
+  glm::vec3 m_position;
+  float m_fov, m_aspect, m_near, m_far;
+  glm::mat4 m_view, m_projection, m_viewProjection;
+  bool m_viewDirty, m_projectionDirty;
+
+public:
+  Camera(float fovDegrees, int viewportWidth, int viewportHeight, float nearPlane, float farPlane);
+
+  void SetPosition(const glm::vec3 &position);
+  void SetViewport(int width, int height);
+
+  const glm::mat4 &GetViewProjection();
+  inline const glm::vec3 &GetPosition() const { return m_position; }
+};
@@ -0,0 +1,302 @@
+#include <algorithm>
+#include <functional>
+
+#include "flowField.h"
+#include "threadPool.h"
+
+static constexpr unsigned int NoKey = 0xFFFFFFFF;
+
+// heap entries pack the cost above the cell index so they sort by cost.
+static inline unsigned long long HeapEntry(unsigned int cost, unsigned int cell)
+{
+  return ((unsigned long long)cost << 32) | cell;
+}
+
+static void HeapPush(std::vector<unsigned long long> &heap, unsigned long long entry)
+{
+  heap.push_back(entry);
+  std::push_heap(heap.begin(), heap.end(), std::greater<unsigned long long>());
+}
+
+static unsigned long long HeapPop(std::vector<unsigned long long> &heap)
+{
+  std::pop_heap(heap.begin(), heap.end(), std::greater<unsigned long long>());
+  unsigned long long entry = heap.back();
+  heap.pop_back();
+  return entry;
+}
+
+FlowField::FlowField(const NavGrid &grid, GridCell goal)
+    : m_grid(grid), m_goal(goal),
+      m_integration(grid.GetCellCount(), Unreachable),
+      m_directions(grid.GetCellCount(), NoDirection),
+      m_affected(grid.GetCellCount(), 0)
+{
+}
+
+void FlowField::Build()
+{
+  std::fill(m_integration.begin(), m_integration.end(), Unreachable);
+  std::fill(m_directions.begin(), m_directions.end(), NoDirection);
+  if (!m_grid.IsPassable(m_goal.x, m_goal.y))
+    return;
+
+  std::vector<unsigned long long> heap;
+  unsigned int goal = m_grid.Index(m_goal.x, m_goal.y);
+  m_integration[goal] = 0;
+  HeapPush(heap, HeapEntry(0, goal));
+  RunDijkstra(heap);
+}
+
+void FlowField::RunDijkstra(std::vector<unsigned long long> &heap)
+{
+  while (!heap.empty())
+  {
+    unsigned long long entry = HeapPop(heap);
+    unsigned int cost = (unsigned int)(entry >> 32);
+    unsigned int cell = (unsigned int)entry;
+    // stale entry, the cell was reached more cheaply after it was pushed.
+    if (cost > m_integration[cell])
+      continue;
+
+    GridCell c = m_grid.Cell(cell);
+    unsigned char cellCost = m_grid.GetCost(cell);
+    for (int d = 0; d < 8; d++)
+    {
+      if (!m_grid.CanStep(c.x, c.y, d))
+        continue;
+      unsigned int neighbour = m_grid.Index(c.x + NavDirX[d], c.y + NavDirY[d]);
+      unsigned int newCost = cost + NavGrid::StepCost(cellCost, m_grid.GetCost(neighbour), d);
+      if (newCost < m_integration[neighbour])
+      {
+        m_integration[neighbour] = newCost;
+        m_directions[neighbour] = (unsigned char)((d + 4) & 7);
+        HeapPush(heap, HeapEntry(newCost, neighbour));
+      }
+    }
+  }
+}
+
+// marks root and every cell whose path to the goal passes through it.
+void FlowField::MarkSubtree(unsigned int root)
+{
+  if (m_affected[root])
+    return;
+  m_affected[root] = 1;
+  size_t first = m_affectedCells.size();
+  m_affectedCells.push_back(root);
+  for (size_t i = first; i < m_affectedCells.size(); i++)
+  {
+    unsigned int cell = m_affectedCells[i];
+    GridCell c = m_grid.Cell(cell);
+    for (int d = 0; d < 8; d++)
+    {
+      int nx = c.x + NavDirX[d], ny = c.y + NavDirY[d];
+      if (!m_grid.InBounds(nx, ny))
+        continue;
+      unsigned int neighbour = m_grid.Index(nx, ny);
+      if (!m_affected[neighbour] && m_directions[neighbour] == ((d + 4) & 7))
+      {
+        m_affected[neighbour] = 1;
+        m_affectedCells.push_back(neighbour);
+      }
+    }
+  }
+}
+
+void FlowField::Update(const std::vector<unsigned int> &changedCells)
+{
+  if (changedCells.empty())
+    return;
+
+  m_affectedCells.clear();
+  for (unsigned int cell : changedCells)
+  {
+    MarkSubtree(cell);
+    // a diagonal step next to a changed tile may have become a corner cut.
+    GridCell c = m_grid.Cell(cell);
+    for (int d = 0; d < 8; d++)
+    {
+      int nx = c.x + NavDirX[d], ny = c.y + NavDirY[d];
+      if (!m_grid.InBounds(nx, ny))
+        continue;
+      unsigned char dir = m_directions[m_grid.Index(nx, ny)];
+      if (dir == NoDirection || !(dir & 1))
+        continue;
+      bool cutsCorner = (nx + NavDirX[dir] == c.x && ny == c.y) || (nx == c.x && ny + NavDirY[dir] == c.y);
+      if (cutsCorner)
+        MarkSubtree(m_grid.Index(nx, ny));
+    }
+  }
+
+  for (unsigned int cell : m_affectedCells)
+  {
+    m_integration[cell] = Unreachable;
+    m_directions[cell] = NoDirection;
+  }
+
+  // reseed the affected region from the untouched cells around it, then let
+  // Dijkstra spread inward and on into any cell the change made cheaper.
+  std::vector<unsigned long long> heap;
+  unsigned int goal = m_grid.Index(m_goal.x, m_goal.y);
+  for (unsigned int cell : m_affectedCells)
+  {
+    if (cell == goal)
+    {
+      if (m_grid.IsPassable(m_goal.x, m_goal.y))
+      {
+        m_integration[cell] = 0;
+        HeapPush(heap, HeapEntry(0, cell));
+      }
+      continue;
+    }
+    GridCell c = m_grid.Cell(cell);
+    if (!m_grid.IsPassable(c.x, c.y))
+      continue;
+    unsigned int best = Unreachable;
+    unsigned char bestDir = NoDirection;
+    for (int d = 0; d < 8; d++)
+    {
+      if (!m_grid.CanStep(c.x, c.y, d))
+        continue;
+      unsigned int neighbour = m_grid.Index(c.x + NavDirX[d], c.y + NavDirY[d]);
+      if (m_affected[neighbour] || m_integration[neighbour] == Unreachable)
+        continue;
+      unsigned int cost = m_integration[neighbour] + NavGrid::StepCost(m_grid.GetCost(cell), m_grid.GetCost(neighbour), d);
+      if (cost < best)
+      {
+        best = cost;
+        bestDir = (unsigned char)d;
+      }
+    }
+    if (best != Unreachable)
+    {
+      m_integration[cell] = best;
+      m_directions[cell] = bestDir;
+      HeapPush(heap, HeapEntry(best, cell));
+    }
+  }
+
+  // a tile that got cheaper or opened up changes the steps around it, including
+  // diagonals between its neighbours that no longer cut a corner. Relaxing
+  // from those neighbours again carries any improvement outward.
+  for (unsigned int cell : changedCells)
+  {
+    GridCell c = m_grid.Cell(cell);
+    for (int d = 0; d < 8; d++)
+    {
+      int nx = c.x + NavDirX[d], ny = c.y + NavDirY[d];
+      if (!m_grid.InBounds(nx, ny))
+        continue;
+      unsigned int neighbour = m_grid.Index(nx, ny);
+      if (!m_affected[neighbour] && m_integration[neighbour] != Unreachable)
+        HeapPush(heap, HeapEntry(m_integration[neighbour], neighbour));
+    }
+  }
+
+  for (unsigned int cell : m_affectedCells)
+    m_affected[cell] = 0;
+  RunDijkstra(heap);
+}
+
+glm::vec2 FlowField::GetDirection(int x, int y) const
+{
+  static const float Diagonal = 0.70710678f;
+  static const glm::vec2 Directions[8] = {
+      glm::vec2(1.0f, 0.0f), glm::vec2(Diagonal, Diagonal),
+      glm::vec2(0.0f, 1.0f), glm::vec2(-Diagonal, Diagonal),
+      glm::vec2(-1.0f, 0.0f), glm::vec2(-Diagonal, -Diagonal),
+      glm::vec2(0.0f, -1.0f), glm::vec2(Diagonal, -Diagonal)};
+  unsigned char d = m_directions[m_grid.Index(x, y)];
+  return d == NoDirection ? glm::vec2(0.0f) : Directions[d];
+}
+
+FlowFieldCache::FlowFieldCache(const NavGrid &grid, unsigned int capacity, ThreadPool *pool)
+    : m_grid(grid), m_pool(pool), m_capacity(std::max(capacity, 1u)), m_tick(0)
+{
+}
+
+const FlowField &FlowFieldCache::Get(GridCell goal)
+{
+  unsigned int key = m_grid.Index(goal.x, goal.y);
+  auto it = m_entries.find(key);
+  if (it == m_entries.end())
+  {
+    std::unique_ptr<FlowField> field = std::make_unique<FlowField>(m_grid, goal);
+    field->Build();
+    it = m_entries.emplace(key, Entry{std::move(field), 0}).first;
+  }
+  it->second.lastUsed = ++m_tick;
+  Evict(key);
+  return *it->second.field;
+}
+
+void FlowFieldCache::Prepare(const std::vector<GridCell> &goals)
+{
+  std::vector<FlowField *> missing;
+  for (const GridCell &goal : goals)
+  {
+    unsigned int key = m_grid.Index(goal.x, goal.y);
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+    {
+      it = m_entries.emplace(key, Entry{std::make_unique<FlowField>(m_grid, goal), 0}).first;
+      missing.push_back(it->second.field.get());
+    }
+    it->second.lastUsed = ++m_tick;
+  }
+
+  auto build = [&missing](unsigned int begin, unsigned int end)
+  {
+    for (unsigned int i = begin; i < end; i++)
+      missing[i]->Build();
+  };
+  if (m_pool)
+    m_pool->ParallelFor((unsigned int)missing.size(), 1, build);
+  else
+    build(0, (unsigned int)missing.size());
+
+  Evict(NoKey);
+}
+
+void FlowFieldCache::ApplyGridChanges()
+{
+  const std::vector<unsigned int> &changed = m_grid.GetChangedCells();
+  if (changed.empty() || m_entries.empty())
+    return;
+
+  std::vector<FlowField *> fields;
+  for (auto &entry : m_entries)
+    fields.push_back(entry.second.field.get());
+
+  auto update = [&fields, &changed](unsigned int begin, unsigned int end)
+  {
+    for (unsigned int i = begin; i < end; i++)
+      fields[i]->Update(changed);
+  };
+  if (m_pool)
+    m_pool->ParallelFor((unsigned int)fields.size(), 1, update);
+  else
+    update(0, (unsigned int)fields.size());
+}
+
+void FlowFieldCache::Clear()
+{
+  m_entries.clear();
+}
+
+void FlowFieldCache::Evict(unsigned int keep)
+{
+  while (m_entries.size() > m_capacity)
+  {
+    auto oldest = m_entries.end();
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+      if (it->first != keep && (oldest == m_entries.end() || it->second.lastUsed < oldest->second.lastUsed))
+        oldest = it;
+    }
+    if (oldest == m_entries.end())
+      return;
+    m_entries.erase(oldest);
+  }
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "navGrid.h"
+
+class ThreadPool;
+
+// Integration and direction fields toward one goal. Every reachable cell
+// stores its cost to the goal and the direction of the next step, so any
+// number of agents can look up where to go in O(1).
+class FlowField
+{
+public:
+  static constexpr unsigned int Unreachable = 0xFFFFFFFF;
+
+private:
+  const NavGrid &m_grid;
+  GridCell m_goal;
+  std::vector<unsigned int> m_integration;
+  // direction of the next step toward the goal, also the shortest path tree
+  // used to find which cells a tile change affects.
+  std::vector<unsigned char> m_directions;
+  // scratch for Update, kept to avoid reallocating every call.
+  std::vector<unsigned char> m_affected;
+  std::vector<unsigned int> m_affectedCells;
+
+public:
+  FlowField(const NavGrid &grid, GridCell goal);
+
+  void Build();
+  // repairs the field after the given cells changed cost, only cells whose
+  // path went through a changed cell are recomputed.
+  void Update(const std::vector<unsigned int> &changedCells);
+
+  inline GridCell GetGoal() const { return m_goal; }
+  inline unsigned int GetIntegration(int x, int y) const { return m_integration[m_grid.Index(x, y)]; }
+  inline unsigned char GetDirectionIndex(int x, int y) const { return m_directions[m_grid.Index(x, y)]; }
+  // unit vector toward the next cell, zero at the goal or when unreachable.
+  glm::vec2 GetDirection(int x, int y) const;
+
+private:
+  void RunDijkstra(std::vector<unsigned long long> &heap);
+  void MarkSubtree(unsigned int root);
+};
+
+// Flow fields per goal, built on demand and kept up to date as the grid
+// changes. Least recently used fields are dropped past the capacity.
+class FlowFieldCache
+{
+private:
+  struct Entry
+  {
+    std::unique_ptr<FlowField> field;
+    unsigned long long lastUsed;
+  };
+
+  const NavGrid &m_grid;
+  ThreadPool *m_pool;
+  unsigned int m_capacity;
+  std::unordered_map<unsigned int, Entry> m_entries;
+  unsigned long long m_tick;
+
+public:
+  FlowFieldCache(const NavGrid &grid, unsigned int capacity = 16, ThreadPool *pool = nullptr);
+
+  // the reference stays valid until a later Get or Prepare evicts it.
+  const FlowField &Get(GridCell goal);
+  // builds every missing field in parallel, ahead of the Get calls.
+  void Prepare(const std::vector<GridCell> &goals);
+  // applies the grid's changed cells to every cached field, in parallel.
+  void ApplyGridChanges();
+  void Clear();
+
+  inline unsigned int GetCount() const { return (unsigned int)m_entries.size(); }
+
+private:
+  void Evict(unsigned int keep);
+};
@@ -0,0 +1,181 @@
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <fstream>
+
+// imgui vendors stb_truetype, keep our copy of the implementation private.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-function"
+#define STBTT_STATIC
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <imstb_truetype.h>
+#pragma GCC diagnostic pop
+
+#include "font.h"
+#include "log.h"
+#include "texture.h"
+
+// distance field spread in pixels around the glyph edge.
+static constexpr int SdfPadding = 6;
+static constexpr unsigned char SdfOnEdgeValue = 128;
+
+static unsigned int DecodeUtf8(const std::string &text, size_t &i)
+{
+  unsigned char c = (unsigned char)text[i++];
+  if (c < 0x80)
+    return c;
+  int extra = c >= 0xF0 ? 3 : c >= 0xE0 ? 2 : c >= 0xC0 ? 1 : 0;
+  unsigned int codepoint = c & (0x3F >> extra);
+  for (int n = 0; n < extra && i < text.size(); n++)
+    codepoint = (codepoint << 6) | ((unsigned char)text[i++] & 0x3F);
+  return extra == 0 ? 0xFFFD : codepoint;
+}
+
+Font::Font(const std::string &path, float pixelHeight, int atlasSize)
+    : m_pixelHeight(pixelHeight), m_scale(0.0f), m_ascent(0.0f), m_descent(0.0f),
+      m_lineGap(0.0f), m_atlasSize(atlasSize), m_shelfX(0), m_shelfY(0),
+      m_shelfHeight(0), m_dirtyMinY(atlasSize), m_dirtyMaxY(0)
+{
+  std::ifstream stream(path, std::ios::binary);
+  if (!stream)
+  {
+    LOG_ERROR(LogCategory::Asset, "Failed to open font: %s", path.c_str());
+    return;
+  }
+  m_fontData.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+
+  std::unique_ptr<stbtt_fontinfo> info = std::make_unique<stbtt_fontinfo>();
+  if (!stbtt_InitFont(info.get(), m_fontData.data(), stbtt_GetFontOffsetForIndex(m_fontData.data(), 0)))
+  {
+    LOG_ERROR(LogCategory::Asset, "Failed to parse font: %s", path.c_str());
+    return;
+  }
+  m_info = std::move(info);
+
+  m_scale = stbtt_ScaleForPixelHeight(m_info.get(), m_pixelHeight);
+  int ascent, descent, lineGap;
+  stbtt_GetFontVMetrics(m_info.get(), &ascent, &descent, &lineGap);
+  m_ascent = ascent * m_scale;
+  m_descent = descent * m_scale;
+  m_lineGap = lineGap * m_scale;
+  m_atlasPixels.assign((size_t)m_atlasSize * m_atlasSize, 0);
+}
+
+Font::~Font() {}
+
+bool Font::PackGlyph(int width, int height, int &x, int &y)
+{
+  // simple shelf packer, glyphs are similar heights so little space is lost.
+  if (m_shelfX + width + 1 > m_atlasSize)
+  {
+    m_shelfX = 0;
+    m_shelfY += m_shelfHeight + 1;
+    m_shelfHeight = 0;
+  }
+  if (width + 1 > m_atlasSize || m_shelfY + height + 1 > m_atlasSize)
+    return false;
+  x = m_shelfX;
+  y = m_shelfY;
+  m_shelfX += width + 1;
+  m_shelfHeight = std::max(m_shelfHeight, height);
+  return true;
+}
+
+const Glyph *Font::GetGlyph(unsigned int codepoint)
+{
+  auto cached = m_glyphs.find(codepoint);
+  if (cached != m_glyphs.end())
+    return &cached->second;
+  if (!m_info)
+    return nullptr;
+
+  Glyph glyph{};
+  int advance, leftSideBearing;
+  stbtt_GetCodepointHMetrics(m_info.get(), (int)codepoint, &advance, &leftSideBearing);
+  glyph.advance = advance * m_scale;
+
+  int width = 0, height = 0, xoff = 0, yoff = 0;
+  unsigned char *sdf = stbtt_GetCodepointSDF(m_info.get(), m_scale, (int)codepoint, SdfPadding,
+                                             SdfOnEdgeValue, (float)SdfOnEdgeValue / SdfPadding,
+                                             &width, &height, &xoff, &yoff);
+  // whitespace has no bitmap, only an advance.
+  if (sdf)
+  {
+    int x, y;
+    if (PackGlyph(width, height, x, y))
+    {
+      for (int row = 0; row < height; row++)
+        std::copy(sdf + row * width, sdf + (row + 1) * width,
+                  m_atlasPixels.begin() + (size_t)(y + row) * m_atlasSize + x);
+      m_dirtyMinY = std::min(m_dirtyMinY, y);
+      m_dirtyMaxY = std::max(m_dirtyMaxY, y + height);
+
+      glyph.offset = glm::vec2((float)xoff, (float)yoff);
+      glyph.size = glm::vec2((float)width, (float)height);
+      glyph.uvMin = glm::vec2((float)x / m_atlasSize, (float)y / m_atlasSize);
+      glyph.uvMax = glm::vec2((float)(x + width) / m_atlasSize, (float)(y + height) / m_atlasSize);
+    }
+    else
+    {
+      LOG_WARN(LogCategory::Asset, "Font atlas full, glyph %u not added", codepoint);
+    }
+    stbtt_FreeSDF(sdf, nullptr);
+  }
+
+  return &m_glyphs.emplace(codepoint, glyph).first->second;
+}
+
+void Font::LayoutText(const std::string &text, TextLayout &layout)
+{
+  layout.quads.clear();
+  layout.size = glm::vec2(0.0f);
+  if (!m_info)
+    return;
+
+  glm::vec2 pen(0.0f, m_ascent);
+  unsigned int previous = 0;
+  size_t i = 0;
+  while (i < text.size())
+  {
+    unsigned int codepoint = DecodeUtf8(text, i);
+    if (codepoint == '\n')
+    {
+      layout.size.x = std::max(layout.size.x, pen.x);
+      pen = glm::vec2(0.0f, pen.y + GetLineHeight());
+      previous = 0;
+      continue;
+    }
+
+    const Glyph *glyph = GetGlyph(codepoint);
+    if (previous)
+      pen.x += stbtt_GetCodepointKernAdvance(m_info.get(), (int)previous, (int)codepoint) * m_scale;
+    if (glyph->size.x > 0.0f)
+    {
+      glm::vec2 min = pen + glyph->offset;
+      layout.quads.push_back({min, min + glyph->size, glyph->uvMin, glyph->uvMax});
+    }
+    pen.x += glyph->advance;
+    previous = codepoint;
+  }
+  layout.size.x = std::max(layout.size.x, pen.x);
+  layout.size.y = pen.y - m_descent;
+}
+
+void Font::UploadAtlas()
+{
+  if (!m_info)
+    return;
+  if (!m_atlasTexture)
+  {
+    m_atlasTexture = std::make_unique<Texture>(m_atlasSize, m_atlasSize);
+    m_dirtyMinY = 0;
+    m_dirtyMaxY = m_atlasSize;
+  }
+  if (m_dirtyMinY >= m_dirtyMaxY)
+    return;
+
+  // whole rows, one upload per frame no matter how many glyphs were added.
+  m_atlasTexture->SetSubImage(0, m_dirtyMinY, m_atlasSize, m_dirtyMaxY - m_dirtyMinY,
+                              m_atlasPixels.data() + (size_t)m_dirtyMinY * m_atlasSize);
+  m_dirtyMinY = m_atlasSize;
+  m_dirtyMaxY = 0;
+}
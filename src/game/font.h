@@ -0,0 +1,72 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct stbtt_fontinfo;
+class Texture;
+
+// one rasterized glyph, sizes are in pixels at the font's base size.
+struct Glyph
+{
+  glm::vec2 offset;   // top left of the quad relative to the pen on the baseline
+  glm::vec2 size;
+  glm::vec2 uvMin, uvMax;
+  float advance;
+};
+
+struct GlyphQuad
+{
+  glm::vec2 min, max;
+  glm::vec2 uvMin, uvMax;
+};
+
+// text shaped once at the base size, placed and scaled when drawn.
+struct TextLayout
+{
+  std::vector<GlyphQuad> quads;
+  glm::vec2 size;
+  unsigned long long lastUsedFrame;
+};
+
+// TrueType font rasterized into a signed distance field atlas on demand.
+// Glyphs are generated on the CPU, the atlas texture is only created and
+// updated by UploadAtlas, so layout does not need a GL context.
+class Font
+{
+private:
+  std::vector<unsigned char> m_fontData;
+  std::unique_ptr<stbtt_fontinfo> m_info;
+  float m_pixelHeight;
+  float m_scale;
+  float m_ascent, m_descent, m_lineGap;
+  std::unordered_map<unsigned int, Glyph> m_glyphs;
+
+  std::vector<unsigned char> m_atlasPixels;
+  int m_atlasSize;
+  int m_shelfX, m_shelfY, m_shelfHeight;
+  // region of m_atlasPixels not yet copied to the texture.
+  int m_dirtyMinY, m_dirtyMaxY;
+  std::unique_ptr<Texture> m_atlasTexture;
+
+public:
+  Font(const std::string &path, float pixelHeight = 48.0f, int atlasSize = 1024);
+  ~Font();
+
+  inline bool IsLoaded() const { return m_info != nullptr; }
+  inline float GetPixelHeight() const { return m_pixelHeight; }
+  inline float GetLineHeight() const { return m_ascent - m_descent + m_lineGap; }
+
+  // shapes UTF-8 text at the base size, rasterizing missing glyphs.
+  void LayoutText(const std::string &text, TextLayout &layout);
+  const Glyph *GetGlyph(unsigned int codepoint);
+
+  // pushes newly rasterized glyphs to the GPU, needs a GL context.
+  void UploadAtlas();
+  inline const Texture *GetAtlas() const { return m_atlasTexture.get(); }
+
+private:
+  bool PackGlyph(int width, int height, int &x, int &y);
+};
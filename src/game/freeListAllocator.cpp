@@ -0,0 +1,85 @@
+#include <iterator>
+
+#include "freeListAllocator.h"
+
+FreeListAllocator::FreeListAllocator(unsigned int size)
+    : m_size(size), m_used(0), m_nodePool(64),
+      m_freeByOffset(PoolAllocator<Node>(&m_nodePool)), m_freeBySize(PoolAllocator<Node>(&m_nodePool))
+{
+  if (size > 0)
+    AddFreeBlock(0, size);
+}
+
+void FreeListAllocator::AddFreeBlock(unsigned int offset, unsigned int size)
+{
+  m_freeByOffset.emplace(offset, size);
+  m_freeBySize.emplace(size, offset);
+}
+
+void FreeListAllocator::RemoveFreeBlock(unsigned int offset, unsigned int size)
+{
+  m_freeByOffset.erase(offset);
+  auto range = m_freeBySize.equal_range(size);
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (it->second == offset)
+    {
+      m_freeBySize.erase(it);
+      return;
+    }
+  }
+}
+
+unsigned int FreeListAllocator::Allocate(unsigned int size, unsigned int alignment)
+{
+  if (size == 0 || alignment == 0)
+    return InvalidOffset;
+
+  // smallest block first, padding for alignment may push past a candidate.
+  for (auto it = m_freeBySize.lower_bound(size); it != m_freeBySize.end(); ++it)
+  {
+    unsigned int blockOffset = it->second, blockSize = it->first;
+    unsigned int offset = (blockOffset + alignment - 1) / alignment * alignment;
+    unsigned int padding = offset - blockOffset;
+    if (padding + size > blockSize)
+      continue;
+
+    RemoveFreeBlock(blockOffset, blockSize);
+    if (padding > 0)
+      AddFreeBlock(blockOffset, padding);
+    if (padding + size < blockSize)
+      AddFreeBlock(offset + size, blockSize - padding - size);
+    m_used += size;
+    return offset;
+  }
+  return InvalidOffset;
+}
+
+void FreeListAllocator::Free(unsigned int offset, unsigned int size)
+{
+  if (size == 0)
+    return;
+  m_used -= size;
+
+  auto next = m_freeByOffset.lower_bound(offset);
+  if (next != m_freeByOffset.end() && next->first == offset + size)
+  {
+    unsigned int nextSize = next->second;
+    RemoveFreeBlock(next->first, nextSize);
+    size += nextSize;
+  }
+  next = m_freeByOffset.lower_bound(offset);
+  if (next != m_freeByOffset.begin())
+  {
+    auto previous = std::prev(next);
+    if (previous->first + previous->second == offset)
+    {
+      unsigned int previousOffset = previous->first;
+      unsigned int previousSize = previous->second;
+      RemoveFreeBlock(previousOffset, previousSize);
+      offset = previousOffset;
+      size += previousSize;
+    }
+  }
+  AddFreeBlock(offset, size);
+}
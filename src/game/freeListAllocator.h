@@ -0,0 +1,49 @@
+#pragma once
+#include <functional>
+#include <map>
+
+#include "poolAllocator.h"
+
+// Hands out offset ranges of a fixed size region, without touching the
+// memory itself, so it can manage GPU buffers as well as CPU ones. Free
+// blocks are found best fit and merged with their neighbours when freed.
+class FreeListAllocator
+{
+private:
+  using Node = std::pair<const unsigned int, unsigned int>;
+  using OffsetMap = std::map<unsigned int, unsigned int, std::less<unsigned int>, PoolAllocator<Node>>;
+  using SizeMap = std::multimap<unsigned int, unsigned int, std::less<unsigned int>, PoolAllocator<Node>>;
+
+  unsigned int m_size;
+  unsigned int m_used;
+  // map nodes come from a pool, so allocating and freeing ranges does not
+  // touch the heap once the pool has grown to the busiest free list.
+  BlockPool m_nodePool;
+  // the same free blocks twice: by offset for merging, by size for best fit.
+  OffsetMap m_freeByOffset;
+  SizeMap m_freeBySize;
+
+public:
+  static constexpr unsigned int InvalidOffset = 0xFFFFFFFF;
+
+  FreeListAllocator(unsigned int size);
+
+  // the maps point at m_nodePool.
+  FreeListAllocator(const FreeListAllocator &) = delete;
+  FreeListAllocator &operator=(const FreeListAllocator &) = delete;
+
+  // offset is a multiple of alignment, which does not have to be a power of
+  // two. Returns InvalidOffset when no free block is large enough.
+  unsigned int Allocate(unsigned int size, unsigned int alignment = 1);
+  // size must match the size passed to Allocate.
+  void Free(unsigned int offset, unsigned int size);
+
+  inline unsigned int GetSize() const { return m_size; }
+  inline unsigned int GetUsed() const { return m_used; }
+  inline unsigned int GetFreeBlockCount() const { return (unsigned int)m_freeByOffset.size(); }
+  inline unsigned int GetLargestFreeBlock() const { return m_freeBySize.empty() ? 0 : m_freeBySize.rbegin()->first; }
+
+private:
+  void AddFreeBlock(unsigned int offset, unsigned int size);
+  void RemoveFreeBlock(unsigned int offset, unsigned int size);
+};
@@ -2,24 +2,31 @@
 #include <SDL3/SDL.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <string>
 
 #include <imgui.h>
 #include <imgui_impl_sdl3.h>
 #include <imgui_impl_opengl3.h>
 
+#include "camera.h"
+#include "font.h"
 #include "game.h"
-#include "indexBuffer.h"
+#include "gpuMemory.h"
+#include "linearArena.h"
+#include "log.h"
+#include "memoryStats.h"
 #include "renderer.h"
 #include "shader.h"
+#include "textRenderer.h"
 #include "texture.h"
-#include "vertexArray.h"
-#include "vertexBuffer.h"
+#include "transformHierarchy.h"
 #include "vertexBufferLayout.h"
 
 bool Game::Init()
 {
   bool initialized = false;
+  Log::Init();
   if (!SDL_Init(SDL_INIT_VIDEO))
   {
     SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "Error",
@@ -40,14 +47,14 @@ bool Game::Init()
                        SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE);
   if (!m_state.window)
   {
-    SDL_Log("Error with Create Window: %s", SDL_GetError());
+    LOG_ERROR(LogCategory::App, "Error with Create Window: %s", SDL_GetError());
     return initialized;
   }
 
   m_state.glcontext = SDL_GL_CreateContext(m_state.window);
   if (!m_state.glcontext)
   {
-    SDL_Log("Error with Create Context: %s", SDL_GetError());
+    LOG_ERROR(LogCategory::App, "Error with Create Context: %s", SDL_GetError());
     return initialized;
   }
 
@@ -65,7 +72,7 @@ bool Game::Init()
   GLenum glewError = glewInit();
   if (glewError != GLEW_OK)
   {
-    SDL_Log("Glew Error: %s, %d", glewGetErrorString(glewError), glewError);
+    LOG_ERROR(LogCategory::App, "Glew Error: %s, %u", (const char *)glewGetErrorString(glewError), glewError);
     return initialized;
   }
 
@@ -89,7 +96,7 @@ bool Game::Init()
 void Game::Run()
 {
   bool running = true;
-  SDL_Log("running...");
+  LOG_INFO(LogCategory::App, "running...");
 
   // data to go to the gpu
   // float vertices[] = {
@@ -129,17 +136,13 @@ void Game::Run()
       5, 6, 7,
       5, 7, 8};
 
-  // create vertex attrib object VAO
-  VertexArray va;
-  // create vertex buffer object VBO
-  VertexBuffer vb(vertices, 9 * 5 * sizeof(float));
+  // meshes share a few large buffers owned by the memory manager.
+  GpuMemoryManager gpuMemory;
   // create and save the layout.
   VertexBufferLayout layout;
   layout.Push<float>(3); // pos
   layout.Push<float>(2); // tex
-  va.AddBuffer(vb, layout);
-  // create indicies buffer object IBO
-  IndexBuffer ib(indices, 18);
+  Mesh pyramidMesh = gpuMemory.CreateMesh(layout, vertices, 9, indices, 18);
 
   // get and compile shader from file
   Shader shader("data/res/Basic.shader");
@@ -149,10 +152,22 @@ void Game::Run()
   Renderer renderer;
   Texture texture("data/textures/brick.png");
   texture.Bind();
+  // text is laid out in game resolution and scaled up with the window.
+  Font font("data/fonts/Roboto-Medium.ttf");
+  TextRenderer text(font);
+  glm::mat4 textProjection = glm::ortho(0.0f, (float)m_state.gameWidth, (float)m_state.gameHeight, 0.0f, -1.0f, 1.0f);
 
   float rotation = 0.0f;
   auto currentTime = SDL_GetPerformanceCounter();
   glm::vec3 cameraPos(0.0f,-0.5f, -2.0f);
+  Camera camera(45.0f, m_state.windowWidth, m_state.windowHeight, 0.1f, 100.0f);
+  TransformHierarchy scene;
+  unsigned int pyramid = scene.Add();
+  // transient per frame data, reset at the end of every frame.
+  FrameAllocator frameMemory;
+  MemoryStats::FrameStats frameStats = MemoryStats::EndFrame();
+  // the arena is reset at the end of a frame, so report last frame's use.
+  size_t frameMemoryUsed = 0;
   // start of the running loop
   while (running)
   {
@@ -176,6 +191,7 @@ void Game::Run()
         m_state.windowWidth = event.window.data1;
         m_state.windowHeight = event.window.data2;
         glViewport(0, 0, m_state.windowWidth, m_state.windowHeight);
+        camera.SetViewport(m_state.windowWidth, m_state.windowHeight);
         break;
       }
       }
@@ -184,18 +200,13 @@ void Game::Run()
     if (deltaTime > 60) {
         rotation -= 0.05f;
     }
-      // Model Matrix - model Pos
-      glm::mat4 model = glm::mat4(1.0f); 
-      // View Matrix - Camera Pos
-      glm::mat4 view = glm::mat4(1.0f); 
-      // Projection Matix - 3d effect.
-      glm::mat4 proj = glm::mat4(1.0f);
+      // Model Matrix - only rebuilt for nodes that changed
+      scene.SetRotation(pyramid, glm::angleAxis(glm::radians(rotation), glm::vec3(0.0f,1.0f,0.0f)));
+      scene.Update();
+      // View and Projection - cached until the camera or window changes
+      camera.SetPosition(cameraPos);
       // final output
-      model = glm::rotate(model, glm::radians(rotation), glm::vec3(0.0f,1.0f,0.0f));
-      view = glm::translate(view, cameraPos);
-      proj = glm::perspective(glm::radians(45.0f), (float)(m_state.gameWidth/m_state.gameHeight), 0.1f, 100.0f);
-
-      glm::mat4 mvp = proj* view * model;
+      glm::mat4 mvp = camera.GetViewProjection() * scene.GetWorldMatrix(pyramid);
 
     // Start the Dear ImGui frame
     ImGui_ImplOpenGL3_NewFrame();
@@ -204,16 +215,23 @@ void Game::Run()
     // ImGui::ShowDemoWindow();
     ImGui::SliderFloat3("Camera", &cameraPos.x,-5,5);
     ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
+    ImGui::Text("Heap allocations %llu/frame (%llu bytes), frame memory %zu KB",
+                frameStats.allocations, frameStats.bytes, frameMemoryUsed / 1024);
 
     renderer.Clear();
     shader.Bind();
     shader.SetUniformMat4f("u_MVP", mvp);
-    renderer.Draw(va, ib, shader);
+    renderer.Draw(pyramidMesh, shader);
+    text.DrawText("SDL3-App", glm::vec2(8.0f, 8.0f), 24.0f);
+    text.Flush(renderer, textProjection, frameMemory);
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
 
     SDL_GL_SwapWindow(m_state.window);
     currentTime = SDL_GetPerformanceCounter();
+    frameStats = MemoryStats::EndFrame();
+    frameMemoryUsed = frameMemory.GetUsed();
+    frameMemory.EndFrame();
 
   } // end of running loop
   ImGui_ImplOpenGL3_Shutdown();
@@ -221,6 +239,7 @@ void Game::Run()
   ImGui::DestroyContext();
   SDL_DestroyRenderer(m_state.renderer);
   SDL_DestroyWindow(m_state.window);
+  Log::Shutdown();
 }
 
 void Game::DrawTriangle() {}
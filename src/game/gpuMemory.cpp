@@ -0,0 +1,153 @@
+#include <algorithm>
+
+#include "gpuMemory.h"
+#include "renderer.h"
+#include "vertexArray.h"
+
+BufferAllocation::BufferAllocation(BufferAllocation &&other) noexcept
+    : m_arena(other.m_arena), m_offset(other.m_offset), m_size(other.m_size)
+{
+  other.m_arena = nullptr;
+}
+
+BufferAllocation &BufferAllocation::operator=(BufferAllocation &&other) noexcept
+{
+  if (this != &other)
+  {
+    Release();
+    m_arena = other.m_arena;
+    m_offset = other.m_offset;
+    m_size = other.m_size;
+    other.m_arena = nullptr;
+  }
+  return *this;
+}
+
+void BufferAllocation::Release()
+{
+  if (m_arena)
+    m_arena->Free(m_offset, m_size);
+  m_arena = nullptr;
+}
+
+// uploads go through GL_COPY_WRITE_BUFFER so they never change the index
+// buffer of whichever vertex array happens to be bound.
+BufferArena::BufferArena(unsigned int size)
+    : m_allocator(size)
+{
+  GLCall(glGenBuffers(1, &m_rendererID));
+  GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_rendererID));
+  GLCall(glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, GL_STATIC_DRAW));
+}
+
+BufferArena::~BufferArena()
+{
+  GLCall(glDeleteBuffers(1, &m_rendererID));
+}
+
+BufferAllocation BufferArena::Allocate(const void *data, unsigned int size, unsigned int alignment)
+{
+  unsigned int offset = m_allocator.Allocate(size, alignment);
+  if (offset == FreeListAllocator::InvalidOffset)
+    return BufferAllocation();
+  if (data)
+  {
+    GLCall(glBindBuffer(GL_COPY_WRITE_BUFFER, m_rendererID));
+    GLCall(glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data));
+  }
+  return BufferAllocation(this, offset, size);
+}
+
+void BufferArena::Free(unsigned int offset, unsigned int size)
+{
+  m_allocator.Free(offset, size);
+}
+
+void BufferArena::Bind(unsigned int target) const
+{
+  GLCall(glBindBuffer(target, m_rendererID));
+}
+
+GpuMemoryManager::GpuMemoryManager(unsigned int vertexArenaSize, unsigned int indexArenaSize)
+    : m_vertexArenaSize(vertexArenaSize), m_indexArenaSize(indexArenaSize)
+{
+}
+
+GpuMemoryManager::~GpuMemoryManager() = default;
+
+BufferAllocation GpuMemoryManager::Allocate(std::vector<std::unique_ptr<BufferArena>> &arenas, unsigned int arenaSize,
+                                            const void *data, unsigned int size, unsigned int alignment)
+{
+  for (auto &arena : arenas)
+  {
+    BufferAllocation allocation = arena->Allocate(data, size, alignment);
+    if (allocation.IsValid())
+      return allocation;
+  }
+  // a mesh bigger than the default arena gets an arena of its own size.
+  arenas.push_back(std::make_unique<BufferArena>(std::max(arenaSize, size)));
+  return arenas.back()->Allocate(data, size, alignment);
+}
+
+const VertexArray *GpuMemoryManager::GetVertexArray(const VertexBufferLayout &layout, const BufferArena *arena)
+{
+  unsigned int layoutIndex = 0;
+  while (layoutIndex < m_layouts.size() && !(m_layouts[layoutIndex] == layout))
+    layoutIndex++;
+  if (layoutIndex == m_layouts.size())
+    m_layouts.push_back(layout);
+
+  for (const LayoutArray &entry : m_vertexArrays)
+  {
+    if (entry.layout == layoutIndex && entry.arena == arena)
+      return entry.vertexArray.get();
+  }
+  std::unique_ptr<VertexArray> vertexArray = std::make_unique<VertexArray>();
+  vertexArray->AddBuffer(*arena, layout);
+  vertexArray->Unbind();
+  m_vertexArrays.push_back({layoutIndex, arena, std::move(vertexArray)});
+  return m_vertexArrays.back().vertexArray.get();
+}
+
+Mesh GpuMemoryManager::CreateMesh(const VertexBufferLayout &layout, const void *vertices, unsigned int vertexCount,
+                                  const unsigned int *indices, unsigned int indexCount)
+{
+  unsigned int stride = layout.GetStride();
+  Mesh mesh;
+  // aligned to the stride so the offset is a whole number of vertices.
+  mesh.vertices = Allocate(m_vertexArenas, m_vertexArenaSize, vertices, vertexCount * stride, stride);
+  mesh.indices = Allocate(m_indexArenas, m_indexArenaSize, indices, indexCount * sizeof(unsigned int), sizeof(unsigned int));
+  ASSERT(mesh.vertices.IsValid() && mesh.indices.IsValid());
+  mesh.vertexArray = GetVertexArray(layout, mesh.vertices.GetArena());
+  mesh.indexArena = mesh.indices.GetArena();
+  mesh.baseVertex = (int)(mesh.vertices.GetOffset() / stride);
+  mesh.firstIndex = mesh.indices.GetOffset() / sizeof(unsigned int);
+  mesh.indexCount = indexCount;
+  return mesh;
+}
+
+Mesh GpuMemoryManager::CreateIndexMesh(const unsigned int *indices, unsigned int indexCount)
+{
+  Mesh mesh;
+  mesh.indices = Allocate(m_indexArenas, m_indexArenaSize, indices, indexCount * sizeof(unsigned int), sizeof(unsigned int));
+  ASSERT(mesh.indices.IsValid());
+  mesh.indexArena = mesh.indices.GetArena();
+  mesh.firstIndex = mesh.indices.GetOffset() / sizeof(unsigned int);
+  mesh.indexCount = indexCount;
+  return mesh;
+}
+
+Mesh GpuMemoryManager::CreateMesh(const VertexBufferLayout &layout, const void *vertices, unsigned int vertexCount,
+                                  const Mesh &sharedIndices, unsigned int indexCount)
+{
+  unsigned int stride = layout.GetStride();
+  Mesh mesh;
+  mesh.vertices = Allocate(m_vertexArenas, m_vertexArenaSize, vertices, vertexCount * stride, stride);
+  ASSERT(mesh.vertices.IsValid() && indexCount <= sharedIndices.indexCount);
+  mesh.vertexArray = GetVertexArray(layout, mesh.vertices.GetArena());
+  mesh.indexArena = sharedIndices.indexArena;
+  mesh.baseVertex = (int)(mesh.vertices.GetOffset() / stride);
+  mesh.firstIndex = sharedIndices.firstIndex;
+  mesh.indexCount = indexCount;
+  return mesh;
+}
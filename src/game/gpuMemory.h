@@ -0,0 +1,117 @@
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "freeListAllocator.h"
+#include "vertexBufferLayout.h"
+
+class BufferArena;
+class VertexArray;
+
+// Owns a range of a BufferArena and gives it back when destroyed. Move only,
+// so exactly one handle frees each range.
+class BufferAllocation
+{
+private:
+  BufferArena *m_arena;
+  unsigned int m_offset;
+  unsigned int m_size;
+
+public:
+  BufferAllocation() : m_arena(nullptr), m_offset(0), m_size(0) {}
+  BufferAllocation(BufferArena *arena, unsigned int offset, unsigned int size)
+      : m_arena(arena), m_offset(offset), m_size(size) {}
+  ~BufferAllocation() { Release(); }
+
+  BufferAllocation(const BufferAllocation &) = delete;
+  BufferAllocation &operator=(const BufferAllocation &) = delete;
+  BufferAllocation(BufferAllocation &&other) noexcept;
+  BufferAllocation &operator=(BufferAllocation &&other) noexcept;
+
+  void Release();
+
+  inline bool IsValid() const { return m_arena != nullptr; }
+  inline BufferArena *GetArena() const { return m_arena; }
+  inline unsigned int GetOffset() const { return m_offset; }
+  inline unsigned int GetSize() const { return m_size; }
+};
+
+// One large GL buffer sub-allocated between many meshes.
+class BufferArena
+{
+private:
+  unsigned int m_rendererID;
+  FreeListAllocator m_allocator;
+
+public:
+  BufferArena(unsigned int size);
+  ~BufferArena();
+
+  // handles point at the arena, so it never moves.
+  BufferArena(const BufferArena &) = delete;
+  BufferArena &operator=(const BufferArena &) = delete;
+
+  // copies size bytes of data into a new range, invalid when the arena is full.
+  BufferAllocation Allocate(const void *data, unsigned int size, unsigned int alignment);
+  void Free(unsigned int offset, unsigned int size);
+
+  void Bind(unsigned int target) const;
+  inline unsigned int GetRendererID() const { return m_rendererID; }
+  inline const FreeListAllocator &GetAllocator() const { return m_allocator; }
+};
+
+// Vertices and indices of one mesh inside the shared arenas. baseVertex and
+// firstIndex locate it for glDrawElementsBaseVertex.
+struct Mesh
+{
+  BufferAllocation vertices;
+  BufferAllocation indices;
+  const VertexArray *vertexArray = nullptr;
+  const BufferArena *indexArena = nullptr;
+  int baseVertex = 0;
+  unsigned int firstIndex = 0;
+  unsigned int indexCount = 0;
+};
+
+// Allocates meshes out of a few large vertex and index buffers instead of a
+// buffer object each, so drawing many small meshes needs few binds and the
+// driver sees few allocations. New arenas are added when the existing ones
+// are full. Meshes must be destroyed before the manager.
+class GpuMemoryManager
+{
+private:
+  struct LayoutArray
+  {
+    unsigned int layout;
+    const BufferArena *arena;
+    std::unique_ptr<VertexArray> vertexArray;
+  };
+
+  unsigned int m_vertexArenaSize;
+  unsigned int m_indexArenaSize;
+  std::vector<std::unique_ptr<BufferArena>> m_vertexArenas;
+  std::vector<std::unique_ptr<BufferArena>> m_indexArenas;
+  std::vector<VertexBufferLayout> m_layouts;
+  // one vertex array per layout and vertex arena, shared by their meshes.
+  std::vector<LayoutArray> m_vertexArrays;
+
+public:
+  GpuMemoryManager(unsigned int vertexArenaSize = 4 << 20, unsigned int indexArenaSize = 1 << 20);
+  ~GpuMemoryManager();
+
+  Mesh CreateMesh(const VertexBufferLayout &layout, const void *vertices, unsigned int vertexCount,
+                  const unsigned int *indices, unsigned int indexCount);
+  // indices only, for meshes that all use the same index pattern.
+  Mesh CreateIndexMesh(const unsigned int *indices, unsigned int indexCount);
+  // draws the first indexCount indices of sharedIndices, which has to
+  // outlive the new mesh.
+  Mesh CreateMesh(const VertexBufferLayout &layout, const void *vertices, unsigned int vertexCount,
+                  const Mesh &sharedIndices, unsigned int indexCount);
+
+  inline unsigned int GetArenaCount() const { return (unsigned int)(m_vertexArenas.size() + m_indexArenas.size()); }
+
+private:
+  BufferAllocation Allocate(std::vector<std::unique_ptr<BufferArena>> &arenas, unsigned int arenaSize,
+                            const void *data, unsigned int size, unsigned int alignment);
+  const VertexArray *GetVertexArray(const VertexBufferLayout &layout, const BufferArena *arena);
+};
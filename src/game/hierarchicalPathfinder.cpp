@@ -0,0 +1,478 @@
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+#include "hierarchicalPathfinder.h"
+#include "threadPool.h"
+
+static constexpr unsigned int NoCell = 0xFFFFFFFF;
+// entrances at least this wide get a transition at each end instead of one
+// in the middle, so routes do not all squeeze through the centre.
+static constexpr int WideEntrance = 6;
+
+static inline unsigned long long HeapEntry(unsigned int cost, unsigned int key)
+{
+  return ((unsigned long long)cost << 32) | key;
+}
+
+// admissible for StepCost with the cheapest tile cost of 1.
+static inline unsigned int OctileDistance(GridCell a, GridCell b)
+{
+  unsigned int dx = (unsigned int)std::abs(a.x - b.x);
+  unsigned int dy = (unsigned int)std::abs(a.y - b.y);
+  return 10 * std::max(dx, dy) + 4 * std::min(dx, dy);
+}
+
+HierarchicalPathfinder::HierarchicalPathfinder(const NavGrid &grid, int clusterSize)
+    : m_grid(grid), m_clusterSize(clusterSize),
+      m_clustersX((grid.GetWidth() + clusterSize - 1) / clusterSize),
+      m_clustersY((grid.GetHeight() + clusterSize - 1) / clusterSize)
+{
+  unsigned int count = (unsigned int)(m_clustersX * m_clustersY);
+  m_eastBorders.resize(count);
+  m_southBorders.resize(count);
+  m_clusters.resize(count);
+}
+
+HierarchicalPathfinder::Rect HierarchicalPathfinder::ClusterRect(unsigned int cluster) const
+{
+  int cx = (int)cluster % m_clustersX, cy = (int)cluster / m_clustersX;
+  return {cx * m_clusterSize, cy * m_clusterSize,
+          std::min((cx + 1) * m_clusterSize, m_grid.GetWidth()),
+          std::min((cy + 1) * m_clusterSize, m_grid.GetHeight())};
+}
+
+// scans length tiles from (x0, y0) along the border, pairing each tile with
+// the one across it at (x + dx, y + dy).
+void HierarchicalPathfinder::AddTransitions(std::vector<Transition> &border, int x0, int y0, int dx, int dy, int length)
+{
+  int stepX = dx == 0 ? 1 : 0, stepY = dy == 0 ? 1 : 0;
+  int d = dx != 0 ? 0 : 2;
+  int runStart = -1;
+  for (int i = 0; i <= length; i++)
+  {
+    int x = x0 + i * stepX, y = y0 + i * stepY;
+    bool open = i < length && m_grid.IsPassable(x, y) && m_grid.IsPassable(x + dx, y + dy);
+    if (open && runStart < 0)
+      runStart = i;
+    if (open || runStart < 0)
+      continue;
+
+    int runEnd = i - 1;
+    int picks[2] = {(runStart + runEnd) / 2, -1};
+    if (runEnd - runStart + 1 >= WideEntrance)
+    {
+      picks[0] = runStart;
+      picks[1] = runEnd;
+    }
+    for (int pick : picks)
+    {
+      if (pick < 0)
+        continue;
+      unsigned int a = m_grid.Index(x0 + pick * stepX, y0 + pick * stepY);
+      unsigned int b = m_grid.Index(x0 + pick * stepX + dx, y0 + pick * stepY + dy);
+      border.push_back({a, b, NavGrid::StepCost(m_grid.GetCost(a), m_grid.GetCost(b), d)});
+    }
+    runStart = -1;
+  }
+}
+
+void HierarchicalPathfinder::BuildEastBorder(unsigned int cluster)
+{
+  std::vector<Transition> &border = m_eastBorders[cluster];
+  border.clear();
+  Rect rect = ClusterRect(cluster);
+  if (rect.x1 >= m_grid.GetWidth())
+    return;
+  AddTransitions(border, rect.x1 - 1, rect.y0, 1, 0, rect.y1 - rect.y0);
+}
+
+void HierarchicalPathfinder::BuildSouthBorder(unsigned int cluster)
+{
+  std::vector<Transition> &border = m_southBorders[cluster];
+  border.clear();
+  Rect rect = ClusterRect(cluster);
+  if (rect.y1 >= m_grid.GetHeight())
+    return;
+  AddTransitions(border, rect.x0, rect.y1 - 1, 0, 1, rect.x1 - rect.x0);
+}
+
+void HierarchicalPathfinder::BuildCluster(unsigned int index)
+{
+  Cluster &cluster = m_clusters[index];
+  cluster.nodes.clear();
+  cluster.links.clear();
+  int cx = (int)index % m_clustersX, cy = (int)index / m_clustersX;
+
+  auto slotOf = [&cluster](unsigned int cell)
+  {
+    auto it = std::find(cluster.nodes.begin(), cluster.nodes.end(), cell);
+    if (it != cluster.nodes.end())
+      return (unsigned int)(it - cluster.nodes.begin());
+    cluster.nodes.push_back(cell);
+    return (unsigned int)cluster.nodes.size() - 1;
+  };
+  // own east/south borders hold this cluster's tile in a, the west/north
+  // neighbours' borders hold it in b.
+  auto addBorder = [&](const std::vector<Transition> &border, bool ownSideA)
+  {
+    for (const Transition &t : border)
+    {
+      unsigned int own = ownSideA ? t.a : t.b;
+      unsigned int other = ownSideA ? t.b : t.a;
+      cluster.links.push_back({slotOf(own), other, t.cost, NoCell});
+    }
+  };
+  addBorder(m_eastBorders[index], true);
+  addBorder(m_southBorders[index], true);
+  if (cx > 0)
+    addBorder(m_eastBorders[index - 1], false);
+  if (cy > 0)
+    addBorder(m_southBorders[index - m_clustersX], false);
+
+  unsigned int count = (unsigned int)cluster.nodes.size();
+  cluster.distances.assign(count * count, Unreachable);
+  Rect rect = ClusterRect(index);
+  int width = rect.x1 - rect.x0;
+  auto local = [&](unsigned int cell)
+  {
+    GridCell c = m_grid.Cell(cell);
+    return (unsigned int)((c.y - rect.y0) * width + (c.x - rect.x0));
+  };
+  std::vector<unsigned int> dist;
+  std::vector<unsigned char> dirs;
+  std::vector<unsigned char> targets((size_t)width * (rect.y1 - rect.y0), 0);
+  // costs are symmetric, so each search only has to settle the nodes after
+  // its own and fills both halves of the matrix.
+  for (unsigned int i = 0; i + 1 < count; i++)
+  {
+    for (unsigned int j = i + 1; j < count; j++)
+      targets[local(cluster.nodes[j])] = 1;
+    SearchRect(rect, cluster.nodes[i], NoCell, dist, dirs, &targets, count - i - 1);
+    for (unsigned int j = i + 1; j < count; j++)
+    {
+      unsigned int cell = local(cluster.nodes[j]);
+      targets[cell] = 0;
+      cluster.distances[i * count + j] = dist[cell];
+      cluster.distances[j * count + i] = dist[cell];
+    }
+  }
+}
+
+void HierarchicalPathfinder::Build(ThreadPool *pool)
+{
+  unsigned int count = (unsigned int)m_clusters.size();
+  for (unsigned int i = 0; i < count; i++)
+  {
+    BuildEastBorder(i);
+    BuildSouthBorder(i);
+  }
+  auto build = [this](unsigned int begin, unsigned int end)
+  {
+    for (unsigned int i = begin; i < end; i++)
+      BuildCluster(i);
+  };
+  if (pool)
+    pool->ParallelFor(count, 16, build);
+  else
+    build(0, count);
+
+  NumberNodes();
+  for (unsigned int i = 0; i < count; i++)
+    ResolveLinks(i);
+}
+
+void HierarchicalPathfinder::NumberNodes()
+{
+  m_nodeBase.resize(m_clusters.size());
+  m_nodeCells.clear();
+  m_nodeClusters.clear();
+  for (unsigned int i = 0; i < m_clusters.size(); i++)
+  {
+    m_nodeBase[i] = (unsigned int)m_nodeCells.size();
+    for (unsigned int cell : m_clusters[i].nodes)
+    {
+      m_nodeCells.push_back(cell);
+      m_nodeClusters.push_back(i);
+    }
+  }
+}
+
+void HierarchicalPathfinder::ResolveLinks(unsigned int cluster)
+{
+  for (Link &link : m_clusters[cluster].links)
+  {
+    unsigned int other = ClusterOf(link.cell);
+    const std::vector<unsigned int> &nodes = m_clusters[other].nodes;
+    unsigned int slot = (unsigned int)(std::find(nodes.begin(), nodes.end(), link.cell) - nodes.begin());
+    link.target = m_nodeBase[other] + slot;
+  }
+}
+
+void HierarchicalPathfinder::Update(const std::vector<unsigned int> &changedCells, ThreadPool *pool)
+{
+  std::vector<unsigned char> dirty(m_clusters.size(), 0);
+  std::vector<unsigned char> rebuild(m_clusters.size(), 0);
+  for (unsigned int cell : changedCells)
+    dirty[ClusterOf(cell)] = 1;
+
+  for (unsigned int i = 0; i < dirty.size(); i++)
+  {
+    if (!dirty[i])
+      continue;
+    int cx = (int)i % m_clustersX, cy = (int)i / m_clustersX;
+    BuildEastBorder(i);
+    BuildSouthBorder(i);
+    rebuild[i] = 1;
+    if (cx > 0)
+    {
+      BuildEastBorder(i - 1);
+      rebuild[i - 1] = 1;
+    }
+    if (cy > 0)
+    {
+      BuildSouthBorder(i - m_clustersX);
+      rebuild[i - m_clustersX] = 1;
+    }
+    if (cx + 1 < m_clustersX)
+      rebuild[i + 1] = 1;
+    if (cy + 1 < m_clustersY)
+      rebuild[i + m_clustersX] = 1;
+  }
+
+  std::vector<unsigned int> clusters;
+  for (unsigned int i = 0; i < rebuild.size(); i++)
+  {
+    if (rebuild[i])
+      clusters.push_back(i);
+  }
+  auto build = [this, &clusters](unsigned int begin, unsigned int end)
+  {
+    for (unsigned int i = begin; i < end; i++)
+      BuildCluster(clusters[i]);
+  };
+  if (pool)
+    pool->ParallelFor((unsigned int)clusters.size(), 4, build);
+  else
+    build(0, (unsigned int)clusters.size());
+
+  // numbering shifts past the first rebuilt cluster, so every link is
+  // resolved again; that is one short scan per link.
+  if (clusters.empty())
+    return;
+  NumberNodes();
+  for (unsigned int i = 0; i < m_clusters.size(); i++)
+    ResolveLinks(i);
+}
+
+void HierarchicalPathfinder::SearchRect(const Rect &rect, unsigned int start, unsigned int goal,
+                                        std::vector<unsigned int> &dist, std::vector<unsigned char> &dirs,
+                                        std::vector<unsigned char> *targets, unsigned int targetCount) const
+{
+  int width = rect.x1 - rect.x0;
+  dist.assign((size_t)width * (rect.y1 - rect.y0), Unreachable);
+  dirs.assign(dist.size(), NoDirection);
+  auto local = [&rect, width](int x, int y)
+  { return (unsigned int)((y - rect.y0) * width + (x - rect.x0)); };
+
+  GridCell s = m_grid.Cell(start);
+  GridCell g = goal == NoCell ? s : m_grid.Cell(goal);
+  auto heuristic = [goal, g](GridCell c)
+  { return goal == NoCell ? 0u : OctileDistance(c, g); };
+
+  std::vector<unsigned long long> heap;
+  dist[local(s.x, s.y)] = 0;
+  heap.push_back(HeapEntry(heuristic(s), local(s.x, s.y)));
+  while (!heap.empty())
+  {
+    std::pop_heap(heap.begin(), heap.end(), std::greater<unsigned long long>());
+    unsigned int cell = (unsigned int)heap.back();
+    unsigned int priority = (unsigned int)(heap.back() >> 32);
+    heap.pop_back();
+
+    GridCell c = {rect.x0 + (int)cell % width, rect.y0 + (int)cell / width};
+    unsigned int cost = dist[cell];
+    if (priority > cost + heuristic(c))
+      continue;
+    if (goal != NoCell && c.x == g.x && c.y == g.y)
+      return;
+    if (targets && (*targets)[cell])
+    {
+      (*targets)[cell] = 0;
+      if (--targetCount == 0)
+        return;
+    }
+
+    unsigned char cellCost = m_grid.GetCost(m_grid.Index(c.x, c.y));
+    for (int d = 0; d < 8; d++)
+    {
+      int nx = c.x + NavDirX[d], ny = c.y + NavDirY[d];
+      if (nx < rect.x0 || ny < rect.y0 || nx >= rect.x1 || ny >= rect.y1 || !m_grid.CanStep(c.x, c.y, d))
+        continue;
+      unsigned int neighbour = local(nx, ny);
+      unsigned int newCost = cost + NavGrid::StepCost(cellCost, m_grid.GetCost(m_grid.Index(nx, ny)), d);
+      if (newCost < dist[neighbour])
+      {
+        dist[neighbour] = newCost;
+        dirs[neighbour] = (unsigned char)((d + 4) & 7);
+        heap.push_back(HeapEntry(newCost + heuristic({nx, ny}), neighbour));
+        std::push_heap(heap.begin(), heap.end(), std::greater<unsigned long long>());
+      }
+    }
+  }
+}
+
+// appends the tiles after from up to and including to.
+bool HierarchicalPathfinder::RefineInRect(const Rect &rect, unsigned int from, unsigned int to, std::vector<GridCell> &path) const
+{
+  std::vector<unsigned int> dist;
+  std::vector<unsigned char> dirs;
+  SearchRect(rect, from, to, dist, dirs);
+
+  int width = rect.x1 - rect.x0;
+  GridCell c = m_grid.Cell(to);
+  GridCell f = m_grid.Cell(from);
+  if (dist[(c.y - rect.y0) * width + (c.x - rect.x0)] == Unreachable)
+    return false;
+
+  size_t first = path.size();
+  while (c.x != f.x || c.y != f.y)
+  {
+    path.push_back(c);
+    unsigned char d = dirs[(c.y - rect.y0) * width + (c.x - rect.x0)];
+    c = {c.x + NavDirX[d], c.y + NavDirY[d]};
+  }
+  std::reverse(path.begin() + first, path.end());
+  return true;
+}
+
+bool HierarchicalPathfinder::FindPath(GridCell start, GridCell goal, std::vector<GridCell> &path) const
+{
+  path.clear();
+  if (!m_grid.IsPassable(start.x, start.y) || !m_grid.IsPassable(goal.x, goal.y))
+    return false;
+
+  unsigned int startCell = m_grid.Index(start.x, start.y);
+  unsigned int goalCell = m_grid.Index(goal.x, goal.y);
+  unsigned int startCluster = ClusterOf(startCell);
+  unsigned int goalCluster = ClusterOf(goalCell);
+  Rect startRect = ClusterRect(startCluster);
+  Rect goalRect = ClusterRect(goalCluster);
+
+  // connect start and goal to the entrances of their clusters.
+  std::vector<unsigned int> startDist, goalDist;
+  std::vector<unsigned char> dirs;
+  SearchRect(startRect, startCell, NoCell, startDist, dirs);
+  SearchRect(goalRect, goalCell, NoCell, goalDist, dirs);
+  auto distIn = [](const Rect &rect, const std::vector<unsigned int> &dist, GridCell c)
+  {
+    if (c.x < rect.x0 || c.y < rect.y0 || c.x >= rect.x1 || c.y >= rect.y1)
+      return Unreachable;
+    return dist[(c.y - rect.y0) * (rect.x1 - rect.x0) + (c.x - rect.x0)];
+  };
+
+  // A* over entrance nodes, with start and goal as two extra nodes.
+  unsigned int nodeCount = (unsigned int)m_nodeCells.size();
+  unsigned int startNode = nodeCount, goalNode = nodeCount + 1;
+  auto cellOf = [&](unsigned int node)
+  { return node == startNode ? startCell : node == goalNode ? goalCell : m_nodeCells[node]; };
+  std::vector<unsigned int> costs(nodeCount + 2, Unreachable);
+  std::vector<unsigned int> parents(nodeCount + 2, NoCell);
+  std::vector<unsigned long long> heap;
+  costs[startNode] = 0;
+  heap.push_back(HeapEntry(OctileDistance(start, goal), startNode));
+
+  auto relax = [&](unsigned int from, unsigned int to, unsigned int edgeCost)
+  {
+    unsigned int newCost = costs[from] + edgeCost;
+    if (newCost >= costs[to])
+      return;
+    costs[to] = newCost;
+    parents[to] = from;
+    heap.push_back(HeapEntry(newCost + OctileDistance(m_grid.Cell(cellOf(to)), goal), to));
+    std::push_heap(heap.begin(), heap.end(), std::greater<unsigned long long>());
+  };
+  auto relaxGoal = [&](unsigned int from, GridCell c)
+  {
+    unsigned int d = distIn(goalRect, goalDist, c);
+    if (d != Unreachable)
+      relax(from, goalNode, d);
+  };
+
+  bool found = false;
+  while (!heap.empty())
+  {
+    std::pop_heap(heap.begin(), heap.end(), std::greater<unsigned long long>());
+    unsigned int node = (unsigned int)heap.back();
+    unsigned int priority = (unsigned int)(heap.back() >> 32);
+    heap.pop_back();
+    GridCell c = m_grid.Cell(cellOf(node));
+    if (priority > costs[node] + OctileDistance(c, goal))
+      continue;
+    if (node == goalNode)
+    {
+      found = true;
+      break;
+    }
+
+    if (node == startNode)
+    {
+      unsigned int base = m_nodeBase[startCluster];
+      const std::vector<unsigned int> &nodes = m_clusters[startCluster].nodes;
+      for (unsigned int i = 0; i < nodes.size(); i++)
+      {
+        unsigned int d = distIn(startRect, startDist, m_grid.Cell(nodes[i]));
+        if (d != Unreachable)
+          relax(node, base + i, d);
+      }
+      if (startCluster == goalCluster)
+        relaxGoal(node, c);
+      continue;
+    }
+
+    unsigned int clusterIndex = m_nodeClusters[node];
+    const Cluster &cluster = m_clusters[clusterIndex];
+    unsigned int base = m_nodeBase[clusterIndex];
+    unsigned int i = node - base;
+    unsigned int count = (unsigned int)cluster.nodes.size();
+    for (unsigned int j = 0; j < count; j++)
+    {
+      unsigned int d = cluster.distances[i * count + j];
+      if (j != i && d != Unreachable)
+        relax(node, base + j, d);
+    }
+    for (const Link &link : cluster.links)
+    {
+      if (link.slot == i)
+        relax(node, link.target, link.cost);
+    }
+    if (clusterIndex == goalCluster)
+      relaxGoal(node, c);
+  }
+  if (!found)
+    return false;
+
+  std::vector<unsigned int> route;
+  for (unsigned int node = goalNode; node != startNode; node = parents[node])
+    route.push_back(cellOf(node));
+  route.push_back(startCell);
+  std::reverse(route.begin(), route.end());
+
+  // refine each abstract step to tiles, inside the cluster it runs through.
+  path.push_back(start);
+  for (size_t i = 1; i < route.size(); i++)
+  {
+    unsigned int from = route[i - 1], to = route[i];
+    if (ClusterOf(from) != ClusterOf(to))
+    {
+      path.push_back(m_grid.Cell(to));
+      continue;
+    }
+    if (!RefineInRect(ClusterRect(ClusterOf(from)), from, to, path))
+    {
+      path.clear();
+      return false;
+    }
+  }
+  return true;
+}
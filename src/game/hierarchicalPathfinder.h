@@ -0,0 +1,94 @@
+#pragma once
+#include <vector>
+
+#include "navGrid.h"
+
+class ThreadPool;
+
+// Hierarchical A* for single long routes where a whole flow field would be
+// wasted. The grid is split into square clusters connected through
+// entrances on their borders; a route is searched on that small graph of
+// entrances first and only refined to tiles cluster by cluster. Routes are
+// near optimal rather than shortest, in exchange for searching far fewer tiles.
+class HierarchicalPathfinder
+{
+private:
+  struct Rect
+  {
+    int x0, y0, x1, y1; // max exclusive
+  };
+
+  // a pair of facing tiles on the border between two clusters.
+  struct Transition
+  {
+    unsigned int a, b;
+    unsigned int cost;
+  };
+
+  struct Link
+  {
+    unsigned int slot;
+    unsigned int cell;
+    unsigned int cost;
+    // node the link leads to, resolved once every cluster is built.
+    unsigned int target;
+  };
+
+  struct Cluster
+  {
+    std::vector<unsigned int> nodes;
+    // nodes x nodes costs of the best route inside the cluster.
+    std::vector<unsigned int> distances;
+    // edges through transitions into neighbouring clusters.
+    std::vector<Link> links;
+  };
+
+  const NavGrid &m_grid;
+  int m_clusterSize;
+  int m_clustersX, m_clustersY;
+  // transitions on the east and south border of each cluster.
+  std::vector<std::vector<Transition>> m_eastBorders;
+  std::vector<std::vector<Transition>> m_southBorders;
+  std::vector<Cluster> m_clusters;
+  // nodes of all clusters numbered consecutively, so searches can use flat
+  // arrays instead of maps.
+  std::vector<unsigned int> m_nodeBase;
+  std::vector<unsigned int> m_nodeCells;
+  std::vector<unsigned int> m_nodeClusters;
+
+public:
+  static constexpr unsigned int Unreachable = 0xFFFFFFFF;
+
+  HierarchicalPathfinder(const NavGrid &grid, int clusterSize = 16);
+
+  void Build(ThreadPool *pool = nullptr);
+  // rebuilds only the clusters touching the changed cells.
+  void Update(const std::vector<unsigned int> &changedCells, ThreadPool *pool = nullptr);
+
+  // fills path with the tiles from start to goal, inclusive.
+  bool FindPath(GridCell start, GridCell goal, std::vector<GridCell> &path) const;
+
+  inline unsigned int GetNodeCount() const { return (unsigned int)m_nodeCells.size(); }
+
+private:
+  inline unsigned int ClusterOf(unsigned int cell) const
+  {
+    GridCell c = m_grid.Cell(cell);
+    return (unsigned int)((c.y / m_clusterSize) * m_clustersX + c.x / m_clusterSize);
+  }
+  Rect ClusterRect(unsigned int cluster) const;
+  void BuildEastBorder(unsigned int cluster);
+  void BuildSouthBorder(unsigned int cluster);
+  void BuildCluster(unsigned int cluster);
+  void NumberNodes();
+  void ResolveLinks(unsigned int cluster);
+  void AddTransitions(std::vector<Transition> &border, int x0, int y0, int dx, int dy, int length);
+
+  // Dijkstra, or A* toward goal when one is given, limited to rect. dist and
+  // dirs are indexed relative to rect. With targets, stops once targetCount
+  // of the flagged cells are settled, clearing their flags.
+  void SearchRect(const Rect &rect, unsigned int start, unsigned int goal,
+                  std::vector<unsigned int> &dist, std::vector<unsigned char> &dirs,
+                  std::vector<unsigned char> *targets = nullptr, unsigned int targetCount = 0) const;
+  bool RefineInRect(const Rect &rect, unsigned int from, unsigned int to, std::vector<GridCell> &path) const;
+};
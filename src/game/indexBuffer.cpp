@@ -13,6 +13,23 @@ IndexBuffer::IndexBuffer(const unsigned int *data, unsigned int count)
 
 IndexBuffer::~IndexBuffer() { GLCall(glDeleteBuffers(1, &m_rendererID)); }
 
+IndexBuffer::IndexBuffer(IndexBuffer &&other) noexcept
+    : m_rendererID(other.m_rendererID), m_count(other.m_count) {
+  other.m_rendererID = 0;
+  other.m_count = 0;
+}
+
+IndexBuffer &IndexBuffer::operator=(IndexBuffer &&other) noexcept {
+  if (this != &other) {
+    GLCall(glDeleteBuffers(1, &m_rendererID));
+    m_rendererID = other.m_rendererID;
+    m_count = other.m_count;
+    other.m_rendererID = 0;
+    other.m_count = 0;
+  }
+  return *this;
+}
+
 void IndexBuffer::Bind() const {
   GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_rendererID));
 }
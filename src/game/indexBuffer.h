@@ -9,6 +9,12 @@ public:
   IndexBuffer(const unsigned int *data, unsigned int count);
   ~IndexBuffer();
 
+  // owns the GL buffer, so it can be moved but never copied.
+  IndexBuffer(const IndexBuffer &) = delete;
+  IndexBuffer &operator=(const IndexBuffer &) = delete;
+  IndexBuffer(IndexBuffer &&other) noexcept;
+  IndexBuffer &operator=(IndexBuffer &&other) noexcept;
+
   void Bind() const;
   void Unbind() const;
 
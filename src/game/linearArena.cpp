@@ -0,0 +1,66 @@
+#include <algorithm>
+#include <new>
+
+#include "linearArena.h"
+
+static inline size_t AlignUp(size_t value, size_t alignment)
+{
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+LinearArena::LinearArena(size_t capacity)
+    : m_base((unsigned char *)::operator new(capacity)), m_capacity(capacity), m_offset(0), m_peak(0),
+      m_overflowBytes(0)
+{
+}
+
+LinearArena::~LinearArena()
+{
+  Reset();
+  ::operator delete(m_base);
+}
+
+void *LinearArena::Allocate(size_t size, size_t alignment)
+{
+  size_t offset = AlignUp((size_t)m_base + m_offset, alignment) - (size_t)m_base;
+  if (offset + size <= m_capacity)
+  {
+    m_offset = offset + size;
+    return m_base + offset;
+  }
+
+  // operator new alignment covers everything but over-aligned types. Blocks
+  // go through the global operators so MemoryStats counts the overflow.
+  unsigned char *block = (unsigned char *)::operator new(size + alignment);
+  m_overflow.push_back(block);
+  m_overflowBytes += size + alignment;
+  return (void *)AlignUp((size_t)block, alignment);
+}
+
+void LinearArena::Reset()
+{
+  m_peak = std::max(m_peak, m_offset + m_overflowBytes);
+  for (unsigned char *block : m_overflow)
+    ::operator delete(block);
+  m_overflow.clear();
+  if (m_overflowBytes > 0)
+  {
+    // room for the worst frame seen so far, allocated once.
+    ::operator delete(m_base);
+    m_capacity = m_peak;
+    m_base = (unsigned char *)::operator new(m_capacity);
+  }
+  m_overflowBytes = 0;
+  m_offset = 0;
+}
+
+FrameAllocator::FrameAllocator(size_t capacity)
+    : m_arenas{LinearArena(capacity), LinearArena(capacity)}, m_current(0)
+{
+}
+
+void FrameAllocator::EndFrame()
+{
+  m_current ^= 1;
+  m_arenas[m_current].Reset();
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Bump allocator: allocations are a pointer increment and are all released
+// together by Reset. Running out of space falls back to extra heap blocks,
+// and the next Reset grows the main block to the peak so a repeating
+// workload settles into no heap allocations at all.
+class LinearArena
+{
+private:
+  unsigned char *m_base;
+  size_t m_capacity;
+  size_t m_offset;
+  size_t m_peak;
+  std::vector<unsigned char *> m_overflow;
+  size_t m_overflowBytes;
+
+public:
+  LinearArena(size_t capacity);
+  ~LinearArena();
+
+  LinearArena(const LinearArena &) = delete;
+  LinearArena &operator=(const LinearArena &) = delete;
+
+  // alignment must be a power of two.
+  void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+  template <typename T>
+  T *AllocateArray(size_t count) { return (T *)Allocate(count * sizeof(T), alignof(T)); }
+  // nothing allocated before is valid afterwards.
+  void Reset();
+
+  inline size_t GetUsed() const { return m_offset + m_overflowBytes; }
+  inline size_t GetCapacity() const { return m_capacity; }
+};
+
+// Scratch memory for one frame, from two arenas used on alternate frames.
+// Whatever is allocated stays valid until the end of the next frame, so data
+// handed to the GPU or another system during a frame may be read one frame
+// later. Main thread only.
+class FrameAllocator
+{
+private:
+  LinearArena m_arenas[2];
+  unsigned int m_current;
+
+public:
+  FrameAllocator(size_t capacity = 1 << 20);
+
+  inline void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+  {
+    return m_arenas[m_current].Allocate(size, alignment);
+  }
+  template <typename T>
+  T *AllocateArray(size_t count) { return m_arenas[m_current].AllocateArray<T>(count); }
+
+  // switches to the other arena and releases what it held two frames ago.
+  void EndFrame();
+
+  inline LinearArena &GetArena() { return m_arenas[m_current]; }
+  inline size_t GetUsed() const { return m_arenas[m_current].GetUsed(); }
+  inline size_t GetCapacity() const { return m_arenas[m_current].GetCapacity(); }
+};
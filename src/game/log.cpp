@@ -0,0 +1,236 @@
+#include <SDL3/SDL.h>
+#include <chrono>
+#include <cstdarg>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "log.h"
+
+namespace
+{
+  constexpr unsigned int RingCapacity = 1024; // power of two
+  constexpr unsigned int MessageBytes = 1024;
+
+  // single producer (the owning thread), single consumer (whoever holds
+  // the consumer lock).
+  struct LogRing
+  {
+    LogRecord records[RingCapacity];
+    std::atomic<unsigned long long> head{0};
+    std::atomic<unsigned long long> tail{0};
+    std::atomic<unsigned int> dropped{0};
+  };
+
+  const char *s_categoryNames[] = {"App", "Render", "Shader", "Asset"};
+  static_assert(sizeof(s_categoryNames) / sizeof(s_categoryNames[0]) == (size_t)LogCategory::Count);
+
+  SDL_LogPriority ToPriority(LogLevel level)
+  {
+    switch (level)
+    {
+    case LogLevel::Trace: return SDL_LOG_PRIORITY_TRACE;
+    case LogLevel::Debug: return SDL_LOG_PRIORITY_DEBUG;
+    case LogLevel::Info: return SDL_LOG_PRIORITY_INFO;
+    case LogLevel::Warn: return SDL_LOG_PRIORITY_WARN;
+    default: return SDL_LOG_PRIORITY_ERROR;
+    }
+  }
+
+  struct LogSystem
+  {
+    std::atomic<unsigned char> levels[(int)LogCategory::Count];
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<LogRing>> rings;
+    // held while draining so the writer thread and Flush never consume at once.
+    std::mutex consumerMutex;
+    std::thread writer;
+    std::atomic<bool> running{false};
+    // records dropped over the whole run, added up as the rings are drained.
+    std::atomic<unsigned long long> dropped{0};
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    LogSystem()
+    {
+      for (auto &level : levels)
+        level.store((unsigned char)LogLevel::Trace);
+    }
+    ~LogSystem() { Log::Shutdown(); }
+  };
+
+  LogSystem &GetSystem()
+  {
+    static LogSystem system;
+    return system;
+  }
+
+  thread_local LogRing *t_ring = nullptr;
+
+  LogRing &GetThreadRing()
+  {
+    if (!t_ring)
+    {
+      LogSystem &system = GetSystem();
+      std::lock_guard<std::mutex> lock(system.registryMutex);
+      system.rings.push_back(std::make_unique<LogRing>());
+      t_ring = system.rings.back().get();
+    }
+    return *t_ring;
+  }
+
+  void Output(const LogRecord &record)
+  {
+    char message[MessageBytes];
+    record.formatter(record, message, sizeof(message));
+    SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, ToPriority(record.level), "[%llu.%03llu] [%s] %s",
+                   record.timestamp / 1000, record.timestamp % 1000,
+                   s_categoryNames[(int)record.category], message);
+  }
+
+  // caller holds consumerMutex. Returns how many records were written.
+  unsigned int DrainRings(LogSystem &system)
+  {
+    std::vector<LogRing *> rings;
+    {
+      std::lock_guard<std::mutex> lock(system.registryMutex);
+      for (auto &ring : system.rings)
+        rings.push_back(ring.get());
+    }
+
+    unsigned int written = 0;
+    for (LogRing *ring : rings)
+    {
+      unsigned long long tail = ring->tail.load(std::memory_order_relaxed);
+      unsigned long long head = ring->head.load(std::memory_order_acquire);
+      for (; tail != head; tail++)
+      {
+        Output(ring->records[tail & (RingCapacity - 1)]);
+        written++;
+      }
+      ring->tail.store(tail, std::memory_order_release);
+
+      unsigned int dropped = ring->dropped.exchange(0);
+      if (dropped > 0)
+      {
+        system.dropped.fetch_add(dropped, std::memory_order_relaxed);
+        SDL_LogMessage(SDL_LOG_CATEGORY_APPLICATION, SDL_LOG_PRIORITY_WARN,
+                       "[log] %u messages dropped, buffer full", dropped);
+      }
+    }
+    return written;
+  }
+
+  void WriterLoop()
+  {
+    LogSystem &system = GetSystem();
+    while (system.running.load())
+    {
+      unsigned int written;
+      {
+        std::lock_guard<std::mutex> lock(system.consumerMutex);
+        written = DrainRings(system);
+      }
+      // producers never signal, polling keeps their side free of syscalls.
+      if (written == 0)
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+  }
+}
+
+bool LogRateLimiter::Allow(unsigned long long nowMs, unsigned int &suppressed)
+{
+  suppressed = 0;
+  unsigned long long windowStart = m_windowStart.load(std::memory_order_relaxed);
+  if (nowMs - windowStart >= WindowMs &&
+      m_windowStart.compare_exchange_strong(windowStart, nowMs, std::memory_order_relaxed))
+  {
+    m_count.store(0, std::memory_order_relaxed);
+    suppressed = m_suppressed.exchange(0, std::memory_order_relaxed);
+  }
+  if (m_count.fetch_add(1, std::memory_order_relaxed) < Burst)
+    return true;
+  m_suppressed.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+int LogDetail::FormatString(char *out, unsigned int size, const char *format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  int length = SDL_vsnprintf(out, size, format, args);
+  va_end(args);
+  return length;
+}
+
+void Log::Init()
+{
+  LogSystem &system = GetSystem();
+  if (system.running.exchange(true))
+    return;
+  system.writer = std::thread(WriterLoop);
+}
+
+void Log::Shutdown()
+{
+  LogSystem &system = GetSystem();
+  if (system.running.exchange(false))
+    system.writer.join();
+  Flush();
+}
+
+void Log::Flush()
+{
+  LogSystem &system = GetSystem();
+  std::lock_guard<std::mutex> lock(system.consumerMutex);
+  DrainRings(system);
+}
+
+void Log::SetLevel(LogCategory category, LogLevel level)
+{
+  GetSystem().levels[(int)category].store((unsigned char)level, std::memory_order_relaxed);
+}
+
+bool Log::IsEnabled(LogLevel level, LogCategory category)
+{
+  return (unsigned char)level >= GetSystem().levels[(int)category].load(std::memory_order_relaxed);
+}
+
+unsigned long long Log::GetDroppedCount()
+{
+  return GetSystem().dropped.load(std::memory_order_relaxed);
+}
+
+unsigned long long Log::GetTimeMs()
+{
+  auto elapsed = std::chrono::steady_clock::now() - GetSystem().start;
+  return (unsigned long long)std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+}
+
+LogRecord *Log::BeginRecord()
+{
+  LogRing &ring = GetThreadRing();
+  unsigned long long head = ring.head.load(std::memory_order_relaxed);
+  if (head - ring.tail.load(std::memory_order_acquire) >= RingCapacity)
+  {
+    ring.dropped.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  return &ring.records[head & (RingCapacity - 1)];
+}
+
+void Log::CommitRecord(LogRecord *record)
+{
+  // without the writer thread, or for errors that may be followed by a
+  // breakpoint, write out right away.
+  bool flush = !GetSystem().running.load(std::memory_order_relaxed) || record->level >= LogLevel::Error;
+  LogRing &ring = GetThreadRing();
+  ring.head.store(ring.head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  if (flush)
+    Flush();
+}
+
+void Log::WriteSuppressed(LogLevel level, LogCategory category, unsigned int suppressed)
+{
+  Write(level, category, "(%u similar messages suppressed)", suppressed);
+}
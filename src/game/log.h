@@ -0,0 +1,217 @@
+#pragma once
+#include <atomic>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Asynchronous logging. Each thread writes records into its own lock-free
+// ring buffer, arguments are copied raw and only formatted later on the
+// writer thread started by Log::Init. Levels below LOG_MIN_LEVEL are removed
+// at compile time, and every call site below Error is rate limited so a
+// message repeated every frame cannot flood the output. Errors always get
+// through, since they usually precede an assert.
+
+enum class LogLevel : unsigned char
+{
+  Trace,
+  Debug,
+  Info,
+  Warn,
+  Error,
+  Off
+};
+
+enum class LogCategory : unsigned char
+{
+  App,
+  Render,
+  Shader,
+  Asset,
+  Count
+};
+
+// 0 = Trace ... 4 = Error, anything lower is compiled out.
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL 2
+#else
+#define LOG_MIN_LEVEL 0
+#endif
+#endif
+
+// header plus arguments fill a 512 byte record, longer strings are truncated.
+static constexpr unsigned int LogArgBytes = 480;
+
+template <LogLevel level>
+constexpr bool LogCompiledIn = (int)level >= LOG_MIN_LEVEL;
+
+struct LogRecord;
+using LogFormatFunction = int (*)(const LogRecord &record, char *out, unsigned int size);
+
+struct LogRecord
+{
+  unsigned long long timestamp;
+  const char *format;
+  LogFormatFunction formatter;
+  LogLevel level;
+  LogCategory category;
+  unsigned char args[LogArgBytes];
+};
+
+// lets repeated messages from one call site through in bursts.
+class LogRateLimiter
+{
+private:
+  std::atomic<unsigned long long> m_windowStart{0};
+  std::atomic<unsigned int> m_count{0};
+  std::atomic<unsigned int> m_suppressed{0};
+
+public:
+  static constexpr unsigned int Burst = 8;
+  static constexpr unsigned long long WindowMs = 1000;
+
+  // suppressed is set to the messages dropped since the last allowed one.
+  bool Allow(unsigned long long nowMs, unsigned int &suppressed);
+};
+
+namespace LogDetail
+{
+  template <typename T>
+  using Stored = std::decay_t<T>;
+
+  template <typename T>
+  constexpr bool IsString = std::is_same_v<Stored<T>, const char *> || std::is_same_v<Stored<T>, char *>;
+
+  template <typename T>
+  constexpr unsigned int ScalarSize = IsString<T> ? 0 : sizeof(Stored<T>);
+
+  template <typename T>
+  void Encode(unsigned char *&cursor, unsigned int &stringBudget, const T &value)
+  {
+    if constexpr (IsString<T>)
+    {
+      // arrays decay to a pointer that is never null, only test real pointers.
+      const char *text = value;
+      if constexpr (std::is_pointer_v<T>)
+      {
+        if (!text)
+          text = "(null)";
+      }
+      unsigned int length = (unsigned int)strlen(text);
+      if (length + 1 > stringBudget)
+        length = stringBudget > 0 ? stringBudget - 1 : 0;
+      memcpy(cursor, text, length);
+      cursor[length] = '\0';
+      cursor += length + 1;
+      stringBudget -= length + 1;
+    }
+    else
+    {
+      static_assert(std::is_trivially_copyable_v<Stored<T>>, "log arguments must be trivially copyable");
+      Stored<T> copy = value;
+      memcpy(cursor, &copy, sizeof(copy));
+      cursor += sizeof(copy);
+    }
+  }
+
+  template <typename T>
+  auto Decode(const unsigned char *&cursor)
+  {
+    if constexpr (IsString<T>)
+    {
+      const char *text = (const char *)cursor;
+      cursor += strlen(text) + 1;
+      return text;
+    }
+    else
+    {
+      Stored<T> value;
+      memcpy(&value, cursor, sizeof(value));
+      cursor += sizeof(value);
+      return value;
+    }
+  }
+
+  int FormatString(char *out, unsigned int size, const char *format, ...);
+
+  template <typename... Args>
+  int Format(const LogRecord &record, char *out, unsigned int size)
+  {
+    const unsigned char *cursor = record.args;
+    // braced initialization decodes the arguments left to right.
+    std::tuple<decltype(Decode<Args>(cursor))...> values{Decode<Args>(cursor)...};
+    return std::apply([&](auto... decoded)
+                      { return FormatString(out, size, record.format, decoded...); },
+                      values);
+  }
+}
+
+namespace Log
+{
+  // starts the writer thread, before that messages are written immediately.
+  void Init();
+  // drains every buffer and stops the writer thread.
+  void Shutdown();
+  // writes everything queued so far from the calling thread.
+  void Flush();
+
+  void SetLevel(LogCategory category, LogLevel level);
+  bool IsEnabled(LogLevel level, LogCategory category);
+  unsigned long long GetTimeMs();
+  // records lost to a full buffer so far, only counted once a drain sees them.
+  unsigned long long GetDroppedCount();
+
+  // returns a free record in the calling thread's buffer, nullptr when full.
+  LogRecord *BeginRecord();
+  void CommitRecord(LogRecord *record);
+  void WriteSuppressed(LogLevel level, LogCategory category, unsigned int suppressed);
+
+  template <typename... Args>
+  void Write(LogLevel level, LogCategory category, const char *format, const Args &...args)
+  {
+    LogRecord *record = BeginRecord();
+    if (!record)
+      return;
+    record->timestamp = GetTimeMs();
+    record->format = format;
+    record->formatter = &LogDetail::Format<Args...>;
+    record->level = level;
+    record->category = category;
+    constexpr unsigned int scalarBytes = (0u + ... + LogDetail::ScalarSize<Args>);
+    static_assert(scalarBytes <= LogArgBytes, "too many log arguments");
+    [[maybe_unused]] unsigned int stringBudget = LogArgBytes - scalarBytes;
+    [[maybe_unused]] unsigned char *cursor = record->args;
+    (LogDetail::Encode(cursor, stringBudget, args), ...);
+    CommitRecord(record);
+  }
+}
+
+// never called, only lets the compiler check format strings against arguments.
+inline void LogCheckFormat(const char *, ...) __attribute__((format(printf, 1, 2)));
+inline void LogCheckFormat(const char *, ...) {}
+
+#define LOG_AT(level, category, ...)                                                       \
+  do                                                                                       \
+  {                                                                                        \
+    if constexpr (LogCompiledIn<level>)                                                    \
+    {                                                                                      \
+      if (false)                                                                           \
+        LogCheckFormat(__VA_ARGS__);                                                       \
+      static LogRateLimiter s_logLimiter;                                                  \
+      unsigned int logSuppressed = 0;                                                      \
+      if (Log::IsEnabled(level, category) &&                                               \
+          (level >= LogLevel::Error || s_logLimiter.Allow(Log::GetTimeMs(), logSuppressed))) \
+      {                                                                                    \
+        if (logSuppressed > 0)                                                             \
+          Log::WriteSuppressed(level, category, logSuppressed);                            \
+        Log::Write(level, category, __VA_ARGS__);                                          \
+      }                                                                                    \
+    }                                                                                      \
+  } while (0)
+
+#define LOG_TRACE(category, ...) LOG_AT(LogLevel::Trace, category, __VA_ARGS__)
+#define LOG_DEBUG(category, ...) LOG_AT(LogLevel::Debug, category, __VA_ARGS__)
+#define LOG_INFO(category, ...) LOG_AT(LogLevel::Info, category, __VA_ARGS__)
+#define LOG_WARN(category, ...) LOG_AT(LogLevel::Warn, category, __VA_ARGS__)
+#define LOG_ERROR(category, ...) LOG_AT(LogLevel::Error, category, __VA_ARGS__)
@@ -0,0 +1,81 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "memoryStats.h"
+
+// replacing the global operators is how the counting sees every allocation,
+// including the ones made inside the standard library.
+namespace
+{
+  std::atomic<unsigned long long> s_allocations{0};
+  std::atomic<unsigned long long> s_frees{0};
+  std::atomic<unsigned long long> s_bytes{0};
+  std::atomic<unsigned long long> s_frameAllocations{0};
+  std::atomic<unsigned long long> s_frameFrees{0};
+  std::atomic<unsigned long long> s_frameBytes{0};
+
+  void *CountedAllocate(std::size_t size, std::size_t alignment)
+  {
+    if (size == 0)
+      size = 1;
+    void *pointer = alignment > alignof(std::max_align_t)
+                        ? std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)
+                        : std::malloc(size);
+    if (pointer)
+    {
+      s_allocations.fetch_add(1, std::memory_order_relaxed);
+      s_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    return pointer;
+  }
+
+  void CountedFree(void *pointer)
+  {
+    if (!pointer)
+      return;
+    s_frees.fetch_add(1, std::memory_order_relaxed);
+    std::free(pointer);
+  }
+
+  void *AllocateOrThrow(std::size_t size, std::size_t alignment)
+  {
+    void *pointer = CountedAllocate(size, alignment);
+    if (!pointer)
+      throw std::bad_alloc();
+    return pointer;
+  }
+}
+
+MemoryStats::FrameStats MemoryStats::EndFrame()
+{
+  unsigned long long allocations = s_allocations.load(std::memory_order_relaxed);
+  unsigned long long frees = s_frees.load(std::memory_order_relaxed);
+  unsigned long long bytes = s_bytes.load(std::memory_order_relaxed);
+  FrameStats stats = {allocations - s_frameAllocations.exchange(allocations, std::memory_order_relaxed),
+                      frees - s_frameFrees.exchange(frees, std::memory_order_relaxed),
+                      bytes - s_frameBytes.exchange(bytes, std::memory_order_relaxed)};
+  return stats;
+}
+
+unsigned long long MemoryStats::GetTotalAllocations()
+{
+  return s_allocations.load(std::memory_order_relaxed);
+}
+
+void *operator new(std::size_t size) { return AllocateOrThrow(size, 0); }
+void *operator new[](std::size_t size) { return AllocateOrThrow(size, 0); }
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept { return CountedAllocate(size, 0); }
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept { return CountedAllocate(size, 0); }
+void *operator new(std::size_t size, std::align_val_t alignment) { return AllocateOrThrow(size, (std::size_t)alignment); }
+void *operator new[](std::size_t size, std::align_val_t alignment) { return AllocateOrThrow(size, (std::size_t)alignment); }
+
+void operator delete(void *pointer) noexcept { CountedFree(pointer); }
+void operator delete[](void *pointer) noexcept { CountedFree(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept { CountedFree(pointer); }
+void operator delete[](void *pointer, std::size_t) noexcept { CountedFree(pointer); }
+void operator delete(void *pointer, std::align_val_t) noexcept { CountedFree(pointer); }
+void operator delete[](void *pointer, std::align_val_t) noexcept { CountedFree(pointer); }
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept { CountedFree(pointer); }
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept { CountedFree(pointer); }
@@ -0,0 +1,17 @@
+#pragma once
+
+// Counts every allocation made through global operator new, so per frame
+// heap traffic can be watched; steady state frames should show none.
+namespace MemoryStats
+{
+  struct FrameStats
+  {
+    unsigned long long allocations;
+    unsigned long long frees;
+    unsigned long long bytes;
+  };
+
+  // returns the counts since the previous call and starts counting afresh.
+  FrameStats EndFrame();
+  unsigned long long GetTotalAllocations();
+}
@@ -0,0 +1,32 @@
+#include "navGrid.h"
+
+NavGrid::NavGrid(int width, int height, unsigned char defaultCost)
+    : m_width(width), m_height(height),
+      m_costs((size_t)width * height, defaultCost),
+      m_changedFlags((size_t)width * height, 0)
+{
+}
+
+void NavGrid::SetCost(int x, int y, unsigned char cost)
+{
+  if (!InBounds(x, y))
+    return;
+  unsigned int index = Index(x, y);
+  if (cost == 0)
+    cost = 1;
+  if (m_costs[index] == cost)
+    return;
+  m_costs[index] = cost;
+  if (!m_changedFlags[index])
+  {
+    m_changedFlags[index] = 1;
+    m_changedCells.push_back(index);
+  }
+}
+
+void NavGrid::ClearChanges()
+{
+  for (unsigned int index : m_changedCells)
+    m_changedFlags[index] = 0;
+  m_changedCells.clear();
+}
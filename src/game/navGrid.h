@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+struct GridCell
+{
+  int x, y;
+};
+
+// 8 neighbour directions, counter clockwise from +x. The opposite of d is
+// (d + 4) % 8.
+inline constexpr int NavDirX[8] = {1, 1, 0, -1, -1, -1, 0, 1};
+inline constexpr int NavDirY[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+inline constexpr unsigned char NoDirection = 0xFF;
+
+// Walkable grid with a movement cost per tile. Changed tiles are recorded so
+// flow fields and the hierarchical pathfinder can update incrementally; call
+// ClearChanges once every consumer has seen them.
+class NavGrid
+{
+private:
+  int m_width, m_height;
+  std::vector<unsigned char> m_costs;
+  std::vector<unsigned int> m_changedCells;
+  std::vector<unsigned char> m_changedFlags;
+
+public:
+  static constexpr unsigned char Blocked = 255;
+
+  NavGrid(int width, int height, unsigned char defaultCost = 1);
+
+  // cost is 1 (cheapest) to 254, or Blocked.
+  void SetCost(int x, int y, unsigned char cost);
+
+  inline int GetWidth() const { return m_width; }
+  inline int GetHeight() const { return m_height; }
+  inline unsigned int GetCellCount() const { return (unsigned int)m_costs.size(); }
+  inline unsigned int Index(int x, int y) const { return (unsigned int)(y * m_width + x); }
+  inline GridCell Cell(unsigned int index) const { return {(int)(index % m_width), (int)(index / m_width)}; }
+  inline bool InBounds(int x, int y) const { return x >= 0 && y >= 0 && x < m_width && y < m_height; }
+  inline unsigned char GetCost(unsigned int index) const { return m_costs[index]; }
+  inline bool IsPassable(int x, int y) const { return InBounds(x, y) && m_costs[Index(x, y)] != Blocked; }
+
+  // true when a unit can move from (x, y) one step in direction d. Diagonal
+  // steps may not cut the corner of a blocked tile.
+  inline bool CanStep(int x, int y, int d) const
+  {
+    int nx = x + NavDirX[d], ny = y + NavDirY[d];
+    if (!IsPassable(nx, ny))
+      return false;
+    if (d & 1)
+      return IsPassable(nx, y) && IsPassable(x, ny);
+    return true;
+  }
+
+  // symmetric so distances from the goal equal distances to the goal.
+  // Orthogonal steps between two cost 1 tiles cost 10, diagonal 14.
+  static inline unsigned int StepCost(unsigned char from, unsigned char to, int d)
+  {
+    return (from + to) * ((d & 1) ? 7u : 5u);
+  }
+
+  inline const std::vector<unsigned int> &GetChangedCells() const { return m_changedCells; }
+  void ClearChanges();
+};
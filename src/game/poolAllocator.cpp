@@ -0,0 +1,49 @@
+#include <cstddef>
+#include <new>
+
+#include "poolAllocator.h"
+
+static inline size_t AlignBlock(size_t size)
+{
+  size_t alignment = alignof(std::max_align_t);
+  size = size < sizeof(void *) ? sizeof(void *) : size;
+  return (size + alignment - 1) / alignment * alignment;
+}
+
+BlockPool::BlockPool(size_t blockSize, size_t blocksPerChunk)
+    : m_blockSize(AlignBlock(blockSize)), m_blocksPerChunk(blocksPerChunk), m_freeList(nullptr), m_allocated(0)
+{
+}
+
+BlockPool::~BlockPool()
+{
+  for (void *chunk : m_chunks)
+    ::operator delete(chunk);
+}
+
+void *BlockPool::Allocate()
+{
+  if (!m_freeList)
+  {
+    unsigned char *chunk = (unsigned char *)::operator new(m_blockSize * m_blocksPerChunk);
+    m_chunks.push_back(chunk);
+    // thread the new blocks onto the free list, first block on top.
+    for (size_t i = m_blocksPerChunk; i-- > 0;)
+    {
+      void *block = chunk + i * m_blockSize;
+      *(void **)block = m_freeList;
+      m_freeList = block;
+    }
+  }
+  void *block = m_freeList;
+  m_freeList = *(void **)block;
+  m_allocated++;
+  return block;
+}
+
+void BlockPool::Free(void *block)
+{
+  *(void **)block = m_freeList;
+  m_freeList = block;
+  m_allocated--;
+}
@@ -0,0 +1,72 @@
+#pragma once
+#include <cstddef>
+#include <new>
+#include <vector>
+
+// Fixed size blocks carved out of larger chunks. Freed blocks go on an
+// intrusive free list and are handed out again first, so objects created
+// and destroyed all the time stop reaching the heap once the pool is warm.
+// Chunks are only released with the pool.
+class BlockPool
+{
+private:
+  size_t m_blockSize;
+  size_t m_blocksPerChunk;
+  void *m_freeList;
+  std::vector<void *> m_chunks;
+  size_t m_allocated;
+
+public:
+  BlockPool(size_t blockSize, size_t blocksPerChunk = 256);
+  ~BlockPool();
+
+  BlockPool(const BlockPool &) = delete;
+  BlockPool &operator=(const BlockPool &) = delete;
+
+  void *Allocate();
+  void Free(void *block);
+
+  inline size_t GetBlockSize() const { return m_blockSize; }
+  inline size_t GetAllocatedCount() const { return m_allocated; }
+  inline size_t GetChunkCount() const { return m_chunks.size(); }
+};
+
+// STL allocator over a BlockPool, meant for node based containers such as
+// std::map and std::list whose nodes all have one size. Requests larger than
+// a block, like a vector growing, go to the heap instead.
+template <typename T>
+class PoolAllocator
+{
+private:
+  BlockPool *m_pool;
+
+  template <typename U>
+  friend class PoolAllocator;
+
+public:
+  using value_type = T;
+
+  PoolAllocator(BlockPool *pool) : m_pool(pool) {}
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U> &other) : m_pool(other.m_pool) {}
+
+  T *allocate(size_t count)
+  {
+    if (count * sizeof(T) <= m_pool->GetBlockSize() && alignof(T) <= alignof(std::max_align_t))
+      return (T *)m_pool->Allocate();
+    return (T *)::operator new(count * sizeof(T));
+  }
+
+  void deallocate(T *pointer, size_t count)
+  {
+    if (count * sizeof(T) <= m_pool->GetBlockSize() && alignof(T) <= alignof(std::max_align_t))
+      m_pool->Free(pointer);
+    else
+      ::operator delete(pointer);
+  }
+
+  template <typename U>
+  bool operator==(const PoolAllocator<U> &other) const { return m_pool == other.m_pool; }
+  template <typename U>
+  bool operator!=(const PoolAllocator<U> &other) const { return m_pool != other.m_pool; }
+};
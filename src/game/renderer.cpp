@@ -1,4 +1,7 @@
 #include <SDL3/SDL.h>
+#include <iterator>
+#include "gpuMemory.h"
+#include "log.h"
 #include "renderer.h"
 
 void GLClearError()
@@ -10,12 +13,25 @@ bool GLLogcall(const char *function, const char *file, int line)
 {
   while (GLenum error = glGetError())
   {
-    SDL_Log("OpenGL Error: %d - Function:%s File:%s Line:%d", error, function, file, line);
+    LOG_ERROR(LogCategory::Render, "OpenGL Error: %u - Function:%s File:%s Line:%d", error, function, file, line);
     return false;
   }
   return true;
 }
 
+std::vector<unsigned int> MakeQuadIndices(unsigned int quads)
+{
+  std::vector<unsigned int> indices;
+  indices.reserve(quads * 6);
+  for (unsigned int i = 0; i < quads; i++)
+  {
+    unsigned int v = i * 4;
+    unsigned int quad[] = {v, v + 1, v + 2, v, v + 2, v + 3};
+    indices.insert(indices.end(), std::begin(quad), std::end(quad));
+  }
+  return indices;
+}
+
 void Renderer::Draw(const VertexArray &va, const IndexBuffer &ib, const Shader &shader) const
 {
   shader.Bind();
@@ -24,6 +40,48 @@ void Renderer::Draw(const VertexArray &va, const IndexBuffer &ib, const Shader &
   GLCall(glDrawElements(GL_TRIANGLES, ib.GetCount(), GL_UNSIGNED_INT, nullptr));
 }
 
+void Renderer::Draw(const VertexArray &va, const IndexBuffer &ib, const Shader &shader, unsigned int count) const
+{
+  shader.Bind();
+  va.Bind();
+  ib.Bind();
+  GLCall(glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr));
+}
+
+void Renderer::Draw(const Mesh &mesh, const Shader &shader) const
+{
+  shader.Bind();
+  mesh.vertexArray->Bind();
+  mesh.indexArena->Bind(GL_ELEMENT_ARRAY_BUFFER);
+  GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, mesh.indexCount, GL_UNSIGNED_INT,
+                                  (void *)(mesh.firstIndex * sizeof(unsigned int)), mesh.baseVertex));
+}
+
+void Renderer::Draw(const Mesh *const *meshes, unsigned int count, const Shader &shader) const
+{
+  shader.Bind();
+  const VertexArray *boundArray = nullptr;
+  const BufferArena *boundIndices = nullptr;
+  for (unsigned int i = 0; i < count; i++)
+  {
+    const Mesh *mesh = meshes[i];
+    if (mesh->vertexArray != boundArray)
+    {
+      mesh->vertexArray->Bind();
+      boundArray = mesh->vertexArray;
+      // the index buffer binding is part of the vertex array state.
+      boundIndices = nullptr;
+    }
+    if (mesh->indexArena != boundIndices)
+    {
+      mesh->indexArena->Bind(GL_ELEMENT_ARRAY_BUFFER);
+      boundIndices = mesh->indexArena;
+    }
+    GLCall(glDrawElementsBaseVertex(GL_TRIANGLES, mesh->indexCount, GL_UNSIGNED_INT,
+                                    (void *)(mesh->firstIndex * sizeof(unsigned int)), mesh->baseVertex));
+  }
+}
+
 void Renderer::Clear() const
 {
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -1,5 +1,6 @@
 #pragma once
 #include <GL/glew.h>
+#include <vector>
 #include "vertexArray.h"
 #include "indexBuffer.h"
 #include "shader.h"
@@ -13,9 +14,20 @@
 
 void GLClearError();
 bool GLLogcall(const char* function, const char* file, int line);
+// index list for quads of 4 vertices each, drawn as two triangles.
+std::vector<unsigned int> MakeQuadIndices(unsigned int quads);
+
+struct Mesh;
 
 class Renderer {
   public:
     void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader) const;
+    // draws only the first count indices of ib.
+    void Draw(const VertexArray& va, const IndexBuffer& ib, const Shader& shader, unsigned int count) const;
+    // meshes from a GpuMemoryManager, addressed by base vertex and index offset.
+    void Draw(const Mesh& mesh, const Shader& shader) const;
+    // binds the vertex array and index arena only when they change between
+    // meshes, sort by them to get the fewest binds.
+    void Draw(const Mesh* const* meshes, unsigned int count, const Shader& shader) const;
     void Clear() const;
 };
\ No newline at end of file
@@ -1,14 +1,16 @@
 #include <GL/glew.h>
-#include <SDL3/SDL.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <sstream>
 
+#include "log.h"
 #include "shader.h"
 #include "renderer.h"
 
-ShaderProgramSource Shader::ParseShader(const std::string &filepath)
+namespace
 {
-	std::ifstream stream(filepath);
 	enum class ShaderType
 	{
 		NONE = -1,
@@ -16,87 +18,192 @@ ShaderProgramSource Shader::ParseShader(const std::string &filepath)
 		FRAGMENT = 1
 	};
 
-	std::string line;
-	std::stringstream ss[2];
-	ShaderType type = ShaderType::NONE;
+	struct ShaderParseState
+	{
+		std::stringstream ss[2];
+		ShaderType type = ShaderType::NONE;
+		std::vector<ShaderVariantDesc> variants;
+		std::vector<std::string> includeStack;
+	};
 
-	while (getline(stream, line))
+	// returns the text after the directive when line starts with it.
+	bool MatchDirective(const std::string &line, const char *directive, std::string &rest)
 	{
-		if (line.find("#shader") != std::string::npos)
+		size_t start = line.find_first_not_of(" \t");
+		if (start == std::string::npos || line.compare(start, strlen(directive), directive) != 0)
+			return false;
+		rest = line.substr(start + strlen(directive));
+		return true;
+	}
+
+	void ParseLines(std::istream &stream, const std::string &directory, ShaderParseState &state)
+	{
+		std::string line;
+		std::string rest;
+		while (getline(stream, line))
 		{
-			if (line.find("vertex") != std::string::npos)
+			if (MatchDirective(line, "#shader", rest))
+			{
+				if (rest.find("vertex") != std::string::npos)
+				{
+					state.type = ShaderType::VERTEX;
+				}
+				else if (rest.find("fragment") != std::string::npos)
+				{
+					state.type = ShaderType::FRAGMENT;
+				}
+			}
+			else if (MatchDirective(line, "#variant", rest))
+			{
+				std::istringstream tokens(rest);
+				ShaderVariantDesc desc;
+				if (!(tokens >> desc.Name))
+					continue;
+				std::string define;
+				while (tokens >> define)
+					desc.Defines.push_back(define);
+				state.variants.push_back(desc);
+			}
+			else if (MatchDirective(line, "#include", rest))
 			{
-				type = ShaderType::VERTEX;
+				size_t open = rest.find_first_of("\"<");
+				size_t close = open == std::string::npos ? open : rest.find_first_of("\">", open + 1);
+				if (close == std::string::npos)
+				{
+					LOG_ERROR(LogCategory::Shader, "Malformed shader include: %s", line.c_str());
+					continue;
+				}
+				std::filesystem::path path = std::filesystem::path(directory) / rest.substr(open + 1, close - open - 1);
+				std::string includePath = path.lexically_normal().string();
+				if (std::find(state.includeStack.begin(), state.includeStack.end(), includePath) != state.includeStack.end())
+				{
+					LOG_WARN(LogCategory::Shader, "Recursive shader include skipped: %s", includePath.c_str());
+					continue;
+				}
+				std::ifstream includeStream(includePath);
+				if (!includeStream)
+				{
+					LOG_ERROR(LogCategory::Shader, "Failed to open shader include: %s", includePath.c_str());
+					continue;
+				}
+				state.includeStack.push_back(includePath);
+				ParseLines(includeStream, path.parent_path().string(), state);
+				state.includeStack.pop_back();
 			}
-			else if (line.find("fragment") != std::string::npos)
+			else if (state.type != ShaderType::NONE)
 			{
-				type = ShaderType::FRAGMENT;
+				state.ss[(int)state.type] << line << "\n";
 			}
 		}
-		else
+	}
+
+	bool s_parallelCompileChecked = false;
+	bool s_parallelCompile = false;
+
+	// lets the driver compile and link on its own threads, so glCompileShader and
+	// glLinkProgram return immediately and only status queries block.
+	void EnableParallelCompile()
+	{
+		if (s_parallelCompileChecked)
+			return;
+		s_parallelCompileChecked = true;
+		if (GLEW_KHR_parallel_shader_compile)
 		{
-			ss[(int)type] << line << "\n";
+			GLCall(glMaxShaderCompilerThreadsKHR(0xFFFFFFFF));
+			s_parallelCompile = true;
+		}
+		else if (GLEW_ARB_parallel_shader_compile)
+		{
+			GLCall(glMaxShaderCompilerThreadsARB(0xFFFFFFFF));
+			s_parallelCompile = true;
 		}
 	}
-	return {ss[0].str(), ss[1].str()};
 }
 
-unsigned int Shader::CreateShader(const std::string &vertexShader,
-						  const std::string &fragmentShader)
+ShaderProgramSource Shader::ParseShader(const std::string &filepath)
+{
+	std::ifstream stream(filepath);
+	if (!stream)
+		LOG_ERROR(LogCategory::Shader, "Failed to open shader: %s", filepath.c_str());
+	std::filesystem::path path(filepath);
+	ShaderParseState state;
+	state.includeStack.push_back(path.lexically_normal().string());
+	ParseLines(stream, path.parent_path().string(), state);
+	return {state.ss[0].str(), state.ss[1].str(), state.variants};
+}
+
+ShaderProgramSource Shader::ParseShaderSource(std::istream &stream, const std::string &directory)
 {
-	unsigned int program = glCreateProgram();
-	unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertexShader);
-	unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
+	ShaderParseState state;
+	ParseLines(stream, directory, state);
+	return {state.ss[0].str(), state.ss[1].str(), state.variants};
+}
 
-	glAttachShader(program, vs);
-	glAttachShader(program, fs);
-	glLinkProgram(program);
+std::string Shader::BuildVariantSource(const std::string &source, const std::vector<std::string> &defines)
+{
+	if (defines.empty())
+		return source;
 
-	int isLinked;
-	glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
-	if (isLinked == GL_FALSE)
+	std::string block;
+	for (const std::string &define : defines)
 	{
-		int maxLength;
-		glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
-		char *infoLog = (char *)alloca(
-			maxLength * sizeof(char)); // Use alloca for stack allocation
-		glGetProgramInfoLog(program, maxLength, &maxLength, infoLog);
-		SDL_Log("Failed to link shader program: %s", infoLog);
-		glDeleteProgram(program);
-		glDeleteShader(vs);
-		glDeleteShader(fs);
-		return 0;
+		size_t equals = define.find('=');
+		block += "#define ";
+		if (equals == std::string::npos)
+			block += define + " 1\n";
+		else
+			block += define.substr(0, equals) + " " + define.substr(equals + 1) + "\n";
 	}
 
-	glValidateProgram(program);
-
-	int isValid;
-	glGetProgramiv(program, GL_VALIDATE_STATUS, &isValid);
-	if (isValid == GL_FALSE)
+	// #version has to stay the first statement, defines go right after it.
+	size_t insertAt = 0;
+	size_t version = source.find("#version");
+	if (version != std::string::npos)
 	{
-		int maxLength;
-		glGetProgramiv(program, GL_INFO_LOG_LENGTH, &maxLength);
-		char *infoLog = (char *)alloca(maxLength * sizeof(char));
-		glGetProgramInfoLog(program, maxLength, &maxLength, infoLog);
-		SDL_Log("Shader program validation failed: %s", infoLog);
+		size_t lineEnd = source.find('\n', version);
+		insertAt = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
 	}
-
-	glDeleteShader(vs);
-	glDeleteShader(fs);
-
-	return program;
+	std::string result = source;
+	result.insert(insertAt, block);
+	return result;
 }
 
 Shader::Shader(const std::string &filepath)
-	: m_filePath(filepath), m_rendererID(0)
+	: m_filePath(filepath), m_current(0)
 {
+	EnableParallelCompile();
 	ShaderProgramSource source = ParseShader(m_filePath);
-	m_rendererID = CreateShader(source.VertexSource, source.FragmentSource);
+	// kick off every variant now, none of these calls wait on the driver.
+	SubmitVariant(source, {"", {}});
+	for (const ShaderVariantDesc &desc : source.Variants)
+		SubmitVariant(source, desc);
 }
 
 Shader::~Shader()
 {
-	GLCall(glDeleteProgram(m_rendererID));
+	for (ShaderVariant &variant : m_variants)
+	{
+		if (!variant.resolved)
+		{
+			GLCall(glDeleteShader(variant.vs));
+			GLCall(glDeleteShader(variant.fs));
+		}
+		GLCall(glDeleteProgram(variant.program));
+	}
+}
+
+void Shader::SubmitVariant(const ShaderProgramSource &source, const ShaderVariantDesc &desc)
+{
+	ShaderVariant variant;
+	variant.name = desc.Name;
+	variant.resolved = false;
+	variant.vs = CompileShader(GL_VERTEX_SHADER, BuildVariantSource(source.VertexSource, desc.Defines));
+	variant.fs = CompileShader(GL_FRAGMENT_SHADER, BuildVariantSource(source.FragmentSource, desc.Defines));
+	variant.program = glCreateProgram();
+	glAttachShader(variant.program, variant.vs);
+	glAttachShader(variant.program, variant.fs);
+	glLinkProgram(variant.program);
+	m_variants.push_back(variant);
 }
 
 unsigned int Shader::CompileShader(unsigned int type, const std::string &source)
@@ -105,44 +212,108 @@ unsigned int Shader::CompileShader(unsigned int type, const std::string &source)
 	const char *src = source.c_str();
 	glShaderSource(id, 1, &src, nullptr); // read the docs on this.
 	glCompileShader(id);
-	if (type == GL_VERTEX_SHADER)
+	// the compile status is checked in ResolveVariant, querying it here would
+	// wait for the driver to finish.
+	return id;
+}
+
+void Shader::ResolveVariant(ShaderVariant &variant) const
+{
+	if (variant.resolved)
+		return;
+	variant.resolved = true;
+
+	int isLinked;
+	glGetProgramiv(variant.program, GL_LINK_STATUS, &isLinked);
+	if (isLinked == GL_FALSE)
+	{
+		unsigned int stages[] = {variant.vs, variant.fs};
+		for (unsigned int stage : stages)
+		{
+			int result;
+			glGetShaderiv(stage, GL_COMPILE_STATUS, &result);
+			if (result == GL_FALSE)
+			{
+				int length;
+				glGetShaderiv(stage, GL_INFO_LOG_LENGTH, &length);
+				char *message = (char *)alloca(length * sizeof(char));
+				glGetShaderInfoLog(stage, length, &length, message);
+				LOG_ERROR(LogCategory::Shader, "Failed to compile %s shader (%s, variant '%s'): %s",
+						stage == variant.vs ? "vertex" : "frag", m_filePath.c_str(), variant.name.c_str(), message);
+			}
+		}
+
+		int maxLength;
+		glGetProgramiv(variant.program, GL_INFO_LOG_LENGTH, &maxLength);
+		char *infoLog = (char *)alloca(
+			maxLength * sizeof(char)); // Use alloca for stack allocation
+		glGetProgramInfoLog(variant.program, maxLength, &maxLength, infoLog);
+		LOG_ERROR(LogCategory::Shader, "Failed to link shader program (%s, variant '%s'): %s", m_filePath.c_str(), variant.name.c_str(), infoLog);
+		glDeleteProgram(variant.program);
+		glDeleteShader(variant.vs);
+		glDeleteShader(variant.fs);
+		variant.program = 0;
+		return;
+	}
+
+	glValidateProgram(variant.program);
+
+	int isValid;
+	glGetProgramiv(variant.program, GL_VALIDATE_STATUS, &isValid);
+	if (isValid == GL_FALSE)
 	{
-		SDL_Log("--- Compiling Vertex Shader ---");
+		int maxLength;
+		glGetProgramiv(variant.program, GL_INFO_LOG_LENGTH, &maxLength);
+		char *infoLog = (char *)alloca(maxLength * sizeof(char));
+		glGetProgramInfoLog(variant.program, maxLength, &maxLength, infoLog);
+		LOG_WARN(LogCategory::Shader, "Shader program validation failed (%s, variant '%s'): %s", m_filePath.c_str(), variant.name.c_str(), infoLog);
 	}
-	else
+
+	glDetachShader(variant.program, variant.vs);
+	glDetachShader(variant.program, variant.fs);
+	glDeleteShader(variant.vs);
+	glDeleteShader(variant.fs);
+}
+
+ShaderVariant *Shader::FindVariant(const std::string &name) const
+{
+	for (ShaderVariant &variant : m_variants)
 	{
-		SDL_Log("--- Compiling Fragment Shader ---");
+		if (variant.name == name)
+			return &variant;
 	}
-	SDL_Log("%s", src);
-	SDL_Log("-----------------------------");
-	int result;
-	glGetShaderiv(id, GL_COMPILE_STATUS, &result);
+	return nullptr;
+}
 
-	if (result == GL_FALSE)
+bool Shader::SetVariant(const std::string &name)
+{
+	ShaderVariant *variant = FindVariant(name);
+	if (!variant)
 	{
-		int length;
-		glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
-		char *message = (char *)alloca(length * sizeof(char));
-		glGetShaderInfoLog(id, length, &length, message);
-		if (type == GL_VERTEX_SHADER)
-		{
-			SDL_Log("Failed to compile vertex shader: %s", message);
-		}
-		else
-		{
-			SDL_Log("Failed to compile frag shader: %s", message);
-		}
-		glDeleteShader(id);
-		return 0;
+		LOG_ERROR(LogCategory::Shader, "No shader variant '%s' in %s", name.c_str(), m_filePath.c_str());
+		return false;
 	}
+	m_current = (unsigned int)(variant - m_variants.data());
+	return true;
+}
 
-	return id;
-	return false;
+bool Shader::IsVariantReady(const std::string &name) const
+{
+	ShaderVariant *variant = FindVariant(name);
+	if (!variant || variant->resolved)
+		return true;
+	if (!s_parallelCompile)
+		return false;
+	int completed;
+	glGetProgramiv(variant->program, GL_COMPLETION_STATUS_KHR, &completed);
+	return completed == GL_TRUE;
 }
 
 void Shader::Bind() const
 {
-	GLCall(glUseProgram(m_rendererID));
+	ShaderVariant &variant = m_variants[m_current];
+	ResolveVariant(variant);
+	GLCall(glUseProgram(variant.program));
 }
 void Shader::Unbind() const
 {
@@ -150,35 +321,45 @@ void Shader::Unbind() const
 }
 
 
-void Shader::SetUniform4f(const std::string &name, float v0, float v1, float v2, float v3)
+void Shader::SetUniform4f(const char *name, float v0, float v1, float v2, float v3)
 {
 	GLCall(glUniform4f(GetUnifromLocation(name), v0, v1, v2, v3));
 }
 
-void Shader::SetUniformMat4f(const std::string &name, const glm::mat4& matrix)
+void Shader::SetUniformMat4f(const char *name, const glm::mat4& matrix)
 {
 	GLCall(glUniformMatrix4fv(GetUnifromLocation(name), 1, GL_FALSE, &matrix[0][0]));
 }
 
-void Shader::SetUniform1f(const std::string &name, float value)
+void Shader::SetUniform1f(const char *name, float value)
 {
 	GLCall(glUniform1f(GetUnifromLocation(name), value));
 }
 
-void Shader::SetUniform1i(const std::string &name, int value)
+void Shader::SetUniform1i(const char *name, int value)
 {
 	GLCall(glUniform1i(GetUnifromLocation(name), value));
 }
 
-int Shader::GetUnifromLocation(const std::string &name)
+void Shader::SetUniform2fv(const char *name, int count, const float *values)
 {
-	if (m_uniformLocationCache.find(name) != m_uniformLocationCache.end())
-		m_uniformLocationCache[name];
+	GLCall(glUniform2fv(GetUnifromLocation(name), count, values));
+}
 
-	GLCall(int location = glGetUniformLocation(m_rendererID, name.c_str()));
+int Shader::GetUnifromLocation(const char *name)
+{
+	ShaderVariant &variant = m_variants[m_current];
+	ResolveVariant(variant);
+	for (const UniformLocation &cached : variant.uniformLocationCache)
+	{
+		if (strcmp(cached.name.c_str(), name) == 0)
+			return cached.location;
+	}
+
+	GLCall(int location = glGetUniformLocation(variant.program, name));
 	if (location == -1 )
-		SDL_Log("No uniform found: %s", name.c_str());
-	
-	m_uniformLocationCache[name] = location;
+		LOG_WARN(LogCategory::Shader, "No uniform found: %s", name);
+
+	variant.uniformLocationCache.push_back({name, location});
 	return location;
 }
@@ -1,23 +1,44 @@
 #pragma once
+#include <istream>
 #include <string>
-#include <unordered_map>
+#include <vector>
 #include <glm/glm.hpp>
 
+// one permutation of a shader file, declared with
+// #variant <name> DEFINE DEFINE=value ...
+struct ShaderVariantDesc {
+  std::string Name;
+  std::vector<std::string> Defines;
+};
+
 struct ShaderProgramSource {
   std::string VertexSource;
   std::string FragmentSource;
+  std::vector<ShaderVariantDesc> Variants;
 };
 
-ShaderProgramSource ParseShader(const std::string &filepath);
-unsigned int CompileShader(unsigned int type, const std::string &source);
-unsigned int CreateShader(const std::string &vertexShader,
-                          const std::string &fragmentShader);
+struct UniformLocation {
+  std::string name;
+  int location;
+};
+
+struct ShaderVariant {
+  std::string name;
+  unsigned int program;
+  unsigned int vs, fs;
+  // false until the link status has been checked on first bind.
+  bool resolved;
+  // a handful of uniforms per shader, a linear scan beats hashing and
+  // lookups by const char* never build a std::string.
+  std::vector<UniformLocation> uniformLocationCache;
+};
 
 class Shader {
   private:
-    unsigned int m_rendererID;
     std::string m_filePath;
-    std::unordered_map<std::string, int> m_uniformLocationCache;
+    // compiled up front, resolved lazily on first bind.
+    mutable std::vector<ShaderVariant> m_variants;
+    unsigned int m_current;
 
   public:
     Shader(const std::string& filepath);
@@ -25,15 +46,27 @@ class Shader {
 
     void Bind() const;
     void Unbind() const;
+    // selects the variant used by Bind and the uniform setters, "" is the
+    // default variant with no extra defines.
+    bool SetVariant(const std::string& name);
+    // true when binding the variant will not wait on the driver.
+    bool IsVariantReady(const std::string& name) const;
     //set uniforms
-    void SetUniform4f(const std::string& name, float v0, float v1, float v2, float v3);
-    void SetUniformMat4f(const std::string &name, const glm::mat4& matrix);
-    void SetUniform1f(const std::string& name, float value);
-    void SetUniform1i(const std::string& name, int value);
+    void SetUniform4f(const char* name, float v0, float v1, float v2, float v3);
+    void SetUniformMat4f(const char* name, const glm::mat4& matrix);
+    void SetUniform1f(const char* name, float value);
+    void SetUniform1i(const char* name, int value);
+    void SetUniform2fv(const char* name, int count, const float* values);
+
+    // CPU only, no GL context required.
+    static ShaderProgramSource ParseShader(const std::string &filepath);
+    static ShaderProgramSource ParseShaderSource(std::istream &stream, const std::string &directory = "");
+    static std::string BuildVariantSource(const std::string &source, const std::vector<std::string> &defines);
 
   private:
-    int GetUnifromLocation(const std::string& name);
+    int GetUnifromLocation(const char* name);
+    ShaderVariant* FindVariant(const std::string& name) const;
+    void SubmitVariant(const ShaderProgramSource &source, const ShaderVariantDesc &desc);
+    void ResolveVariant(ShaderVariant &variant) const;
     unsigned int CompileShader(unsigned int type, const std::string &source);
-    ShaderProgramSource ParseShader(const std::string &filepath);
-    unsigned int CreateShader(const std::string &vertexShader, const std::string &fragmentShader);
-};
\ No newline at end of file
+};
@@ -0,0 +1,118 @@
+#include "linearArena.h"
+#include "log.h"
+#include "renderer.h"
+#include "textRenderer.h"
+#include "texture.h"
+#include "vertexBufferLayout.h"
+
+// layouts not drawn for this many frames are dropped from the cache.
+static constexpr unsigned long long LayoutEvictFrames = 120;
+
+TextRenderer::TextRenderer(Font &font)
+    : m_font(font), m_shader("data/res/Text.shader"),
+      m_vb(MaxGlyphs * 4 * sizeof(TextVertex)),
+      m_ib(MakeQuadIndices(MaxGlyphs).data(), MaxGlyphs * 6), m_glyphCount(0), m_frame(0)
+{
+  VertexBufferLayout layout;
+  layout.Push<float>(2);         // pos
+  layout.Push<float>(2);         // tex
+  layout.Push<unsigned char>(4); // color
+  m_va.AddBuffer(m_vb, layout);
+}
+
+const TextLayout &TextRenderer::GetLayout(const std::string &text)
+{
+  auto cached = m_layouts.find(text);
+  if (cached == m_layouts.end())
+  {
+    cached = m_layouts.emplace(text, TextLayout{}).first;
+    m_font.LayoutText(text, cached->second);
+  }
+  cached->second.lastUsedFrame = m_frame;
+  return cached->second;
+}
+
+void TextRenderer::DrawText(const std::string &text, const glm::vec2 &position, float size,
+                            const glm::vec4 &color)
+{
+  m_draws.push_back({&GetLayout(text), position, size, color});
+}
+
+glm::vec2 TextRenderer::MeasureText(const std::string &text, float size)
+{
+  return GetLayout(text).size * (size / m_font.GetPixelHeight());
+}
+
+void TextRenderer::BuildVertices(TextVertex *vertices, unsigned int glyphs) const
+{
+  unsigned int written = 0;
+  for (const TextDraw &draw : m_draws)
+  {
+    float scale = draw.size / m_font.GetPixelHeight();
+    unsigned char color[4];
+    for (int c = 0; c < 4; c++)
+      color[c] = (unsigned char)(glm::clamp(draw.color[c], 0.0f, 1.0f) * 255.0f + 0.5f);
+
+    for (const GlyphQuad &quad : draw.layout->quads)
+    {
+      if (written == glyphs)
+        return;
+      glm::vec2 min = draw.position + quad.min * scale;
+      glm::vec2 max = draw.position + quad.max * scale;
+      TextVertex *v = vertices + written * 4;
+      v[0] = {min, quad.uvMin, {color[0], color[1], color[2], color[3]}};
+      v[1] = {glm::vec2(max.x, min.y), glm::vec2(quad.uvMax.x, quad.uvMin.y), {color[0], color[1], color[2], color[3]}};
+      v[2] = {max, quad.uvMax, {color[0], color[1], color[2], color[3]}};
+      v[3] = {glm::vec2(min.x, max.y), glm::vec2(quad.uvMin.x, quad.uvMax.y), {color[0], color[1], color[2], color[3]}};
+      written++;
+    }
+  }
+}
+
+void TextRenderer::Flush(const Renderer &renderer, const glm::mat4 &projection, FrameAllocator &frameMemory)
+{
+  // unchanged text skips vertex generation and the upload entirely.
+  if (m_draws != m_lastDraws)
+  {
+    unsigned int glyphs = 0;
+    for (const TextDraw &draw : m_draws)
+      glyphs += (unsigned int)draw.layout->quads.size();
+    if (glyphs > MaxGlyphs)
+    {
+      LOG_WARN(LogCategory::Render, "Text batch full, %u glyphs max", MaxGlyphs);
+      glyphs = MaxGlyphs;
+    }
+    // the vertices only live until the upload, scratch memory is enough.
+    TextVertex *vertices = frameMemory.AllocateArray<TextVertex>(glyphs * 4);
+    BuildVertices(vertices, glyphs);
+    m_glyphCount = glyphs;
+    if (m_glyphCount > 0)
+      m_vb.SetData(vertices, m_glyphCount * 4 * (unsigned int)sizeof(TextVertex));
+    m_lastDraws.swap(m_draws);
+  }
+  m_draws.clear();
+
+  if (m_frame % LayoutEvictFrames == 0)
+  {
+    for (auto it = m_layouts.begin(); it != m_layouts.end();)
+    {
+      if (m_frame - it->second.lastUsedFrame > LayoutEvictFrames)
+        it = m_layouts.erase(it);
+      else
+        ++it;
+    }
+  }
+  m_frame++;
+
+  m_font.UploadAtlas();
+  if (m_glyphCount == 0 || !m_font.GetAtlas())
+    return;
+
+  GLCall(glDisable(GL_DEPTH_TEST));
+  m_font.GetAtlas()->Bind(0);
+  m_shader.Bind();
+  m_shader.SetUniformMat4f("u_Projection", projection);
+  m_shader.SetUniform1i("u_Atlas", 0);
+  renderer.Draw(m_va, m_ib, m_shader, m_glyphCount * 6);
+  GLCall(glEnable(GL_DEPTH_TEST));
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "font.h"
+#include "indexBuffer.h"
+#include "shader.h"
+#include "vertexArray.h"
+#include "vertexBuffer.h"
+
+class FrameAllocator;
+class Renderer;
+
+struct TextVertex
+{
+  glm::vec2 position;
+  glm::vec2 uv;
+  unsigned char color[4];
+};
+
+// Queues strings during the frame and draws every glyph in one batched call.
+// Layouts are cached per string, and when the frame's draws match the last
+// frame the vertex buffer is left untouched.
+class TextRenderer
+{
+private:
+  struct TextDraw
+  {
+    const TextLayout *layout;
+    glm::vec2 position;
+    float size;
+    glm::vec4 color;
+
+    bool operator==(const TextDraw &other) const
+    {
+      return layout == other.layout && position == other.position && size == other.size &&
+             color == other.color;
+    }
+  };
+
+  Font &m_font;
+  Shader m_shader;
+  VertexArray m_va;
+  VertexBuffer m_vb;
+  IndexBuffer m_ib;
+  std::unordered_map<std::string, TextLayout> m_layouts;
+  std::vector<TextDraw> m_draws;
+  std::vector<TextDraw> m_lastDraws;
+  unsigned int m_glyphCount;
+  unsigned long long m_frame;
+
+public:
+  static constexpr unsigned int MaxGlyphs = 4096;
+
+  TextRenderer(Font &font);
+
+  // position is the top left of the first line, size the line height, both
+  // in the units of the projection given to Flush.
+  void DrawText(const std::string &text, const glm::vec2 &position, float size,
+                const glm::vec4 &color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+  glm::vec2 MeasureText(const std::string &text, float size);
+
+  // draws everything queued since the last Flush, vertices are built in
+  // frameMemory.
+  void Flush(const Renderer &renderer, const glm::mat4 &projection, FrameAllocator &frameMemory);
+
+private:
+  const TextLayout &GetLayout(const std::string &text);
+  // writes 4 vertices for each of the first glyphs queued glyphs.
+  void BuildVertices(TextVertex *vertices, unsigned int glyphs) const;
+};
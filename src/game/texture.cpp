@@ -1,20 +1,21 @@
 #include <SDL3_image/SDL_image.h>
+#include "log.h"
 #include "texture.h"
 
 Texture::Texture(const std::string &path)
-	: m_rendererID(0), m_filePath(path), m_width(0), m_height(0), m_BPP(0)
+	: m_rendererID(0), m_filePath(path), m_localBuffer(nullptr), m_width(0), m_height(0), m_BPP(0)
 {
 	SDL_Surface* surface = IMG_Load(path.c_str());
 	if (!surface)
 	{
-		SDL_Log("Failed to load image");
+		LOG_ERROR(LogCategory::Asset, "Failed to load image %s", path.c_str());
 		return;
 	}
 	surface = SDL_ConvertSurface(surface, SDL_PIXELFORMAT_RGBA32);
 	m_localBuffer = FlipSurface(surface);
 	if (!m_localBuffer)
 	{
-		SDL_Log("Failed to save image in m_localBuffer");
+		LOG_ERROR(LogCategory::Asset, "Failed to save image in m_localBuffer");
 		return;
 	}
 
@@ -33,6 +34,21 @@ Texture::Texture(const std::string &path)
 	GLCall(glBindTexture(GL_TEXTURE_2D, 0));
 }
 
+Texture::Texture(int width, int height)
+	: m_rendererID(0), m_localBuffer(nullptr), m_width(width), m_height(height), m_BPP(1)
+{
+	GLCall(glGenTextures(1, &m_rendererID));
+	GLCall(glBindTexture(GL_TEXTURE_2D, m_rendererID));
+
+	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+	GLCall(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+	GLCall(glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, m_width, m_height, 0, GL_RED, GL_UNSIGNED_BYTE, nullptr));
+	GLCall(glBindTexture(GL_TEXTURE_2D, 0));
+}
+
 Texture::~Texture()
 {
 	GLCall(glDeleteTextures(1, &m_rendererID));
@@ -53,6 +69,14 @@ void Texture::Unbind() const
 	GLCall(glBindTexture(GL_TEXTURE_2D, 0));
 }
 
+void Texture::SetSubImage(int x, int y, int width, int height, const void* pixels)
+{
+	GLCall(glBindTexture(GL_TEXTURE_2D, m_rendererID));
+	GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+	GLCall(glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RED, GL_UNSIGNED_BYTE, pixels));
+	GLCall(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+}
+
 SDL_Surface* Texture::FlipSurface(SDL_Surface* surface)
 {
 	// helper function from gemini
@@ -62,9 +86,9 @@ SDL_Surface* Texture::FlipSurface(SDL_Surface* surface)
     );
 
     if (!flippedSurface) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-                     "Failed to create flipped surface: %s",
-                     SDL_GetError());
+        LOG_ERROR(LogCategory::Asset,
+                  "Failed to create flipped surface: %s",
+                  SDL_GetError());
         return nullptr;
     }
 
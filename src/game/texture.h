@@ -1,4 +1,5 @@
 #pragma once
+#include <SDL3/SDL.h>
 
 #include "renderer.h"
 
@@ -12,13 +13,18 @@ private:
 
 public:
 	Texture(const std::string &path);
+	// empty single channel texture, filled with SetSubImage.
+	Texture(int width, int height);
 	~Texture();
 
 	void Bind(unsigned int slot = 0) const;
 	void Unbind() const;
+	// rows of one byte per pixel, tightly packed.
+	void SetSubImage(int x, int y, int width, int height, const void* pixels);
 
 	inline int GetWidth() const { return m_width; }
 	inline int GetHeight() const { return m_height; }
-private:
-	SDL_Surface* FlipSurface(SDL_Surface* surface);
+
+	// returns a new vertically flipped copy, caller owns both surfaces.
+	static SDL_Surface* FlipSurface(SDL_Surface* surface);
 };
\ No newline at end of file
@@ -0,0 +1,103 @@
+#include <algorithm>
+
+#include "threadPool.h"
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+    : m_generation(0), m_active(0), m_stop(false)
+{
+  if (threadCount == 0)
+  {
+    unsigned int hardware = std::thread::hardware_concurrency();
+    threadCount = hardware > 1 ? hardware - 1 : 0;
+  }
+  for (unsigned int i = 0; i < threadCount; i++)
+    m_threads.emplace_back(&ThreadPool::WorkerLoop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  for (std::thread &thread : m_threads)
+    thread.join();
+}
+
+void ThreadPool::ParallelFor(unsigned int count, unsigned int minChunk,
+                             const std::function<void(unsigned int, unsigned int)> &function)
+{
+  if (count == 0)
+    return;
+  minChunk = std::max(minChunk, 1u);
+  if (m_threads.empty() || count <= minChunk)
+  {
+    function(0, count);
+    return;
+  }
+
+  // a few chunks per thread so uneven work still balances out.
+  unsigned int chunk = std::max(minChunk, count / (GetConcurrency() * 4));
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // workers still leaving the previous job must not see the fields change.
+    m_finished.wait(lock, [this]
+                    { return m_active == 0; });
+    m_job.function = &function;
+    m_job.count = count;
+    m_job.chunk = chunk;
+    m_job.next.store(0);
+    m_job.completed.store(0);
+    m_generation++;
+  }
+  m_wake.notify_all();
+
+  RunChunks();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_finished.wait(lock, [this]
+                  { return m_job.completed.load() == m_job.count; });
+}
+
+void ThreadPool::WorkerLoop()
+{
+  unsigned long long seen = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_wake.wait(lock, [this, seen]
+                  { return m_stop || m_generation != seen; });
+      if (m_stop)
+        return;
+      seen = m_generation;
+      m_active++;
+    }
+
+    RunChunks();
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_active--;
+    }
+    m_finished.notify_all();
+  }
+}
+
+void ThreadPool::RunChunks()
+{
+  while (true)
+  {
+    unsigned int begin = m_job.next.fetch_add(m_job.chunk);
+    if (begin >= m_job.count)
+      return;
+    unsigned int end = std::min(begin + m_job.chunk, m_job.count);
+    (*m_job.function)(begin, end);
+    if (m_job.completed.fetch_add(end - begin) + (end - begin) == m_job.count)
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_finished.notify_all();
+    }
+  }
+}
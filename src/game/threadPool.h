@@ -0,0 +1,52 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data parallel loops. ParallelFor splits a
+// range into chunks, the calling thread works on chunks too and the call
+// returns once the whole range is done.
+class ThreadPool
+{
+private:
+  struct Job
+  {
+    const std::function<void(unsigned int, unsigned int)> *function = nullptr;
+    unsigned int count = 0;
+    unsigned int chunk = 1;
+    std::atomic<unsigned int> next{0};
+    std::atomic<unsigned int> completed{0};
+  };
+
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  std::condition_variable m_finished;
+  Job m_job;
+  unsigned long long m_generation;
+  unsigned int m_active;
+  bool m_stop;
+
+public:
+  // threadCount of 0 uses one worker per hardware thread minus the caller.
+  explicit ThreadPool(unsigned int threadCount = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // calls function(begin, end) over [0, count) in chunks of at least minChunk.
+  // Not reentrant, only one thread may issue ParallelFor at a time.
+  void ParallelFor(unsigned int count, unsigned int minChunk,
+                   const std::function<void(unsigned int, unsigned int)> &function);
+
+  // workers plus the calling thread.
+  inline unsigned int GetConcurrency() const { return (unsigned int)m_threads.size() + 1; }
+
+private:
+  void WorkerLoop();
+  void RunChunks();
+};
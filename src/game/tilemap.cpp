@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <cmath>
+
+#include "tilemap.h"
+
+Tilemap::Tilemap(int width, int height, int layerCount, float tileSize, int tilesetColumns, int tilesetRows)
+    : m_width(width), m_height(height), m_layerCount(layerCount),
+      m_chunksX((width + ChunkSize - 1) / ChunkSize), m_chunksY((height + ChunkSize - 1) / ChunkSize),
+      m_tileSize(tileSize), m_tilesetColumns(tilesetColumns), m_tilesetRows(tilesetRows),
+      m_tiles((size_t)layerCount * m_chunksX * m_chunksY * ChunkTiles, EmptyTile),
+      m_chunkVersions((size_t)layerCount * m_chunksX * m_chunksY, 0),
+      m_animations(1, TileAnimation{0, 1, 1.0f}),
+      m_tileAnimations((size_t)tilesetColumns * tilesetRows + 1, 0)
+{
+}
+
+void Tilemap::SetTile(int layer, int x, int y, unsigned short tile)
+{
+  if (layer < 0 || layer >= m_layerCount || x < 0 || y < 0 || x >= m_width || y >= m_height)
+    return;
+  if (tile >= m_tileAnimations.size())
+    return;
+  unsigned short &current = m_tiles[TileIndex(layer, x, y)];
+  if (current == tile)
+    return;
+  current = tile;
+  m_chunkVersions[ChunkIndex(layer, x / ChunkSize, y / ChunkSize)]++;
+}
+
+unsigned short Tilemap::GetTile(int layer, int x, int y) const
+{
+  if (layer < 0 || layer >= m_layerCount || x < 0 || y < 0 || x >= m_width || y >= m_height)
+    return EmptyTile;
+  return m_tiles[TileIndex(layer, x, y)];
+}
+
+unsigned int Tilemap::AddAnimation(unsigned short firstTile, unsigned short frameCount, float frameSeconds)
+{
+  if (m_animations.size() >= MaxAnimations || firstTile == EmptyTile || firstTile >= m_tileAnimations.size())
+    return 0;
+  // also catches NaN, GetAnimationOffsets divides by it.
+  if (!(frameSeconds > 0.0f))
+    return 0;
+  // the shader only shifts u, so frames past the end of the row would sample off the tileset.
+  unsigned short framesInRow = (unsigned short)(m_tilesetColumns - (firstTile - 1) % m_tilesetColumns);
+  frameCount = std::clamp<unsigned short>(frameCount, 1, framesInRow);
+  unsigned int slot = (unsigned int)m_animations.size();
+  m_animations.push_back({firstTile, frameCount, frameSeconds});
+  m_tileAnimations[firstTile] = (unsigned char)slot;
+  // animation is a vertex attribute, chunks showing the tile need rebuilding.
+  for (unsigned int &version : m_chunkVersions)
+    version++;
+  return slot;
+}
+
+void Tilemap::GetAnimationOffsets(float seconds, glm::vec2 *offsets) const
+{
+  float tileU = 1.0f / (float)m_tilesetColumns;
+  for (unsigned int i = 0; i < MaxAnimations; i++)
+  {
+    offsets[i] = glm::vec2(0.0f);
+    if (i == 0 || i >= m_animations.size())
+      continue;
+    const TileAnimation &animation = m_animations[i];
+    // wrapped in float first, so the cast stays in range however long the game runs.
+    unsigned int frame = (unsigned int)std::fmod(seconds / animation.frameSeconds, (float)animation.frameCount);
+    offsets[i].x = (float)frame * tileU;
+  }
+}
+
+unsigned int Tilemap::BuildChunkVertices(int layer, int chunkX, int chunkY, TileVertex *vertices) const
+{
+  const unsigned short *tiles = &m_tiles[(size_t)ChunkIndex(layer, chunkX, chunkY) * ChunkTiles];
+  float tileU = 1.0f / (float)m_tilesetColumns;
+  float tileV = 1.0f / (float)m_tilesetRows;
+  float originX = (float)(chunkX * ChunkSize) * m_tileSize;
+  float originY = (float)(chunkY * ChunkSize) * m_tileSize;
+
+  unsigned int written = 0;
+  for (int y = 0; y < ChunkSize; y++)
+  {
+    for (int x = 0; x < ChunkSize; x++)
+    {
+      unsigned short tile = tiles[y * ChunkSize + x];
+      if (tile == EmptyTile)
+        continue;
+      int index = tile - 1;
+      // tileset row 0 is the top of the image, textures are stored flipped.
+      float u0 = (float)(index % m_tilesetColumns) * tileU;
+      float v1 = 1.0f - (float)(index / m_tilesetColumns) * tileV;
+      float u1 = u0 + tileU, v0 = v1 - tileV;
+      float x0 = originX + (float)x * m_tileSize, y0 = originY + (float)y * m_tileSize;
+      float x1 = x0 + m_tileSize, y1 = y0 + m_tileSize;
+      float animation = tile < m_tileAnimations.size() ? (float)m_tileAnimations[tile] : 0.0f;
+
+      TileVertex *v = vertices + written * 4;
+      v[0] = {glm::vec2(x0, y0), glm::vec2(u0, v1), animation};
+      v[1] = {glm::vec2(x1, y0), glm::vec2(u1, v1), animation};
+      v[2] = {glm::vec2(x1, y1), glm::vec2(u1, v0), animation};
+      v[3] = {glm::vec2(x0, y1), glm::vec2(u0, v0), animation};
+      written++;
+    }
+  }
+  return written;
+}
+
+void Tilemap::GetVisibleChunks(const glm::vec2 &min, const glm::vec2 &max, int &x0, int &y0, int &x1, int &y1) const
+{
+  float chunkWorld = (float)ChunkSize * m_tileSize;
+  x0 = std::clamp((int)std::floor(min.x / chunkWorld), 0, m_chunksX);
+  y0 = std::clamp((int)std::floor(min.y / chunkWorld), 0, m_chunksY);
+  x1 = std::clamp((int)std::floor(max.x / chunkWorld) + 1, 0, m_chunksX);
+  y1 = std::clamp((int)std::floor(max.y / chunkWorld) + 1, 0, m_chunksY);
+}
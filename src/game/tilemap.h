@@ -0,0 +1,91 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+
+struct TileVertex
+{
+  glm::vec2 position;
+  glm::vec2 uv;
+  // slot in the animation offset table, 0 for static tiles.
+  float animation;
+};
+
+// frames are consecutive tiles on one row of the tileset.
+struct TileAnimation
+{
+  unsigned short firstTile;
+  unsigned short frameCount;
+  float frameSeconds;
+};
+
+// Tile layers split into fixed size chunks. Tiles are stored chunk by chunk so
+// building one chunk reads contiguous memory, and every chunk carries a
+// version that changes with its tiles so renderers rebuild only those. CPU
+// only, TilemapRenderer draws it.
+class Tilemap
+{
+public:
+  static constexpr int ChunkSize = 32;
+  static constexpr unsigned int ChunkTiles = ChunkSize * ChunkSize;
+  static constexpr unsigned short EmptyTile = 0;
+  // size of u_AnimationOffsets in Tilemap.shader.
+  static constexpr unsigned int MaxAnimations = 16;
+
+private:
+  int m_width, m_height, m_layerCount;
+  int m_chunksX, m_chunksY;
+  float m_tileSize;
+  int m_tilesetColumns, m_tilesetRows;
+  std::vector<unsigned short> m_tiles;
+  std::vector<unsigned int> m_chunkVersions;
+  // slot 0 is the static entry, so animations start at 1.
+  std::vector<TileAnimation> m_animations;
+  // animation slot for each tile id.
+  std::vector<unsigned char> m_tileAnimations;
+
+public:
+  // tile ids start at 1 and count row by row through a tileset of
+  // tilesetColumns x tilesetRows tiles; 0 is an empty tile.
+  Tilemap(int width, int height, int layerCount, float tileSize, int tilesetColumns, int tilesetRows);
+
+  // ignores positions outside the map and ids past the end of the tileset.
+  void SetTile(int layer, int x, int y, unsigned short tile);
+  unsigned short GetTile(int layer, int x, int y) const;
+
+  // frames run right along the tileset row from firstTile, frameCount is
+  // clamped to the tiles left in that row. Returns the animation slot, or 0
+  // when the table is full, firstTile is not in the tileset or frameSeconds
+  // is not positive.
+  unsigned int AddAnimation(unsigned short firstTile, unsigned short frameCount, float frameSeconds);
+  // fills MaxAnimations uv offsets for the given time, offsets[0] is zero.
+  void GetAnimationOffsets(float seconds, glm::vec2 *offsets) const;
+
+  // writes 4 vertices per non empty tile, at most ChunkTiles * 4, and
+  // returns the number of tiles written.
+  unsigned int BuildChunkVertices(int layer, int chunkX, int chunkY, TileVertex *vertices) const;
+  // chunks overlapping the world rectangle, x1 and y1 exclusive.
+  void GetVisibleChunks(const glm::vec2 &min, const glm::vec2 &max, int &x0, int &y0, int &x1, int &y1) const;
+
+  inline unsigned int GetChunkVersion(int layer, int chunkX, int chunkY) const
+  {
+    return m_chunkVersions[ChunkIndex(layer, chunkX, chunkY)];
+  }
+  inline unsigned int ChunkIndex(int layer, int chunkX, int chunkY) const
+  {
+    return (unsigned int)((layer * m_chunksY + chunkY) * m_chunksX + chunkX);
+  }
+
+  inline int GetWidth() const { return m_width; }
+  inline int GetHeight() const { return m_height; }
+  inline int GetLayerCount() const { return m_layerCount; }
+  inline int GetChunksX() const { return m_chunksX; }
+  inline int GetChunksY() const { return m_chunksY; }
+  inline float GetTileSize() const { return m_tileSize; }
+
+private:
+  inline size_t TileIndex(int layer, int x, int y) const
+  {
+    unsigned int chunk = ChunkIndex(layer, x / ChunkSize, y / ChunkSize);
+    return (size_t)chunk * ChunkTiles + (y % ChunkSize) * ChunkSize + (x % ChunkSize);
+  }
+};
@@ -0,0 +1,103 @@
+#include "arenaAllocator.h"
+#include "linearArena.h"
+#include "renderer.h"
+#include "texture.h"
+#include "tilemapRenderer.h"
+
+TilemapRenderer::TilemapRenderer(const Tilemap &map, const Texture &tileset, GpuMemoryManager &gpuMemory)
+    : m_map(map), m_tileset(tileset), m_gpuMemory(gpuMemory), m_shader("data/res/Tilemap.shader"),
+      m_quadIndices(gpuMemory.CreateIndexMesh(MakeQuadIndices(Tilemap::ChunkTiles).data(), Tilemap::ChunkTiles * 6)),
+      m_chunks((size_t)map.GetLayerCount() * map.GetChunksX() * map.GetChunksY()),
+      m_frame(0), m_drawnChunks(0), m_rebuiltChunks(0)
+{
+  m_layout.Push<float>(2); // pos
+  m_layout.Push<float>(2); // tex
+  m_layout.Push<float>(1); // animation slot
+  for (Chunk &chunk : m_chunks)
+  {
+    chunk.built = false;
+    chunk.lastVisibleFrame = 0;
+  }
+}
+
+void TilemapRenderer::RebuildChunk(Chunk &chunk, int layer, int chunkX, int chunkY, TileVertex *vertices)
+{
+  unsigned int tiles = m_map.BuildChunkVertices(layer, chunkX, chunkY, vertices);
+  // the old range goes back to the arena before the new one is allocated.
+  chunk.mesh = Mesh();
+  if (tiles > 0)
+    chunk.mesh = m_gpuMemory.CreateMesh(m_layout, vertices, tiles * 4, m_quadIndices, tiles * 6);
+  chunk.version = m_map.GetChunkVersion(layer, chunkX, chunkY);
+  if (!chunk.built)
+    m_builtChunks.push_back(m_map.ChunkIndex(layer, chunkX, chunkY));
+  chunk.built = true;
+  m_rebuiltChunks++;
+}
+
+void TilemapRenderer::ReleaseStaleChunks()
+{
+  for (size_t i = 0; i < m_builtChunks.size();)
+  {
+    Chunk &chunk = m_chunks[m_builtChunks[i]];
+    if (m_frame - chunk.lastVisibleFrame <= RetainFrames)
+    {
+      i++;
+      continue;
+    }
+    chunk.mesh = Mesh();
+    chunk.built = false;
+    m_builtChunks[i] = m_builtChunks.back();
+    m_builtChunks.pop_back();
+  }
+}
+
+void TilemapRenderer::Draw(const Renderer &renderer, const glm::mat4 &viewProjection, const glm::vec2 &viewMin,
+                           const glm::vec2 &viewMax, float seconds, FrameAllocator &frameMemory)
+{
+  m_frame++;
+  m_drawnChunks = 0;
+  m_rebuiltChunks = 0;
+  int x0, y0, x1, y1;
+  m_map.GetVisibleChunks(viewMin, viewMax, x0, y0, x1, y1);
+
+  ArenaVector<const Mesh *> meshes(ArenaAllocator<const Mesh *>(&frameMemory.GetArena()));
+  meshes.reserve((size_t)m_map.GetLayerCount() * (x1 - x0) * (y1 - y0));
+  // one chunk's worth of vertices, taken on the first rebuild and reused by the rest.
+  TileVertex *scratch = nullptr;
+  // layers in order, so upper layers blend over lower ones.
+  for (int layer = 0; layer < m_map.GetLayerCount(); layer++)
+  {
+    for (int y = y0; y < y1; y++)
+    {
+      for (int x = x0; x < x1; x++)
+      {
+        Chunk &chunk = m_chunks[m_map.ChunkIndex(layer, x, y)];
+        if (!chunk.built || chunk.version != m_map.GetChunkVersion(layer, x, y))
+        {
+          if (!scratch)
+            scratch = frameMemory.AllocateArray<TileVertex>(Tilemap::ChunkTiles * 4);
+          RebuildChunk(chunk, layer, x, y, scratch);
+        }
+        chunk.lastVisibleFrame = m_frame;
+        if (chunk.mesh.indexCount > 0)
+          meshes.push_back(&chunk.mesh);
+      }
+    }
+  }
+  ReleaseStaleChunks();
+  m_drawnChunks = (unsigned int)meshes.size();
+  if (meshes.empty())
+    return;
+
+  glm::vec2 offsets[Tilemap::MaxAnimations];
+  m_map.GetAnimationOffsets(seconds, offsets);
+
+  GLCall(glDisable(GL_DEPTH_TEST));
+  m_tileset.Bind(0);
+  m_shader.Bind();
+  m_shader.SetUniformMat4f("u_ViewProjection", viewProjection);
+  m_shader.SetUniform1i("u_Tileset", 0);
+  m_shader.SetUniform2fv("u_AnimationOffsets", Tilemap::MaxAnimations, &offsets[0].x);
+  renderer.Draw(meshes.data(), (unsigned int)meshes.size(), m_shader);
+  GLCall(glEnable(GL_DEPTH_TEST));
+}
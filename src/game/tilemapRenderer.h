@@ -0,0 +1,66 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "gpuMemory.h"
+#include "shader.h"
+#include "tilemap.h"
+#include "vertexBufferLayout.h"
+
+class FrameAllocator;
+class Renderer;
+class Texture;
+
+// Draws a Tilemap from one static mesh per chunk and layer, allocated from
+// the GpuMemoryManager. Only chunks inside the view are drawn, and a chunk's
+// mesh is built the first time it is seen and rebuilt only after its tiles
+// change. Animated tiles move their uvs in the shader, so they never cause a
+// rebuild. A chunk that stays out of view for RetainFrames frames gives its
+// mesh back to the GpuMemoryManager and is rebuilt if it comes into view
+// again, so only the area around the recent views stays resident.
+class TilemapRenderer
+{
+public:
+  // about five seconds at 60 fps.
+  static constexpr unsigned int RetainFrames = 300;
+
+private:
+  struct Chunk
+  {
+    Mesh mesh;
+    unsigned int version;
+    unsigned int lastVisibleFrame;
+    bool built;
+  };
+
+  const Tilemap &m_map;
+  const Texture &m_tileset;
+  GpuMemoryManager &m_gpuMemory;
+  Shader m_shader;
+  VertexBufferLayout m_layout;
+  // every chunk uses the same quad pattern, one index buffer serves them all.
+  Mesh m_quadIndices;
+  std::vector<Chunk> m_chunks;
+  // indices into m_chunks of every built chunk, so releasing old meshes does
+  // not have to walk the whole map.
+  std::vector<unsigned int> m_builtChunks;
+  unsigned int m_frame;
+  unsigned int m_drawnChunks;
+  unsigned int m_rebuiltChunks;
+
+public:
+  TilemapRenderer(const Tilemap &map, const Texture &tileset, GpuMemoryManager &gpuMemory);
+
+  // viewMin and viewMax are the world rectangle seen through viewProjection.
+  void Draw(const Renderer &renderer, const glm::mat4 &viewProjection, const glm::vec2 &viewMin,
+            const glm::vec2 &viewMax, float seconds, FrameAllocator &frameMemory);
+
+  inline unsigned int GetDrawnChunks() const { return m_drawnChunks; }
+  inline unsigned int GetRebuiltChunks() const { return m_rebuiltChunks; }
+  inline unsigned int GetResidentChunks() const { return (unsigned int)m_builtChunks.size(); }
+
+private:
+  // vertices is scratch space for one chunk's worth of tiles.
+  void RebuildChunk(Chunk &chunk, int layer, int chunkX, int chunkY, TileVertex *vertices);
+  void ReleaseStaleChunks();
+};
@@ -0,0 +1,106 @@
+#include <atomic>
+
+#include "renderer.h"
+#include "transformHierarchy.h"
+#include "threadPool.h"
+
+// below this many nodes the threads cost more than they save.
+static constexpr unsigned int ParallelUpdateThreshold = 4096;
+static constexpr unsigned int ParallelUpdateChunk = 256;
+
+unsigned int TransformHierarchy::Add(unsigned int parent, const glm::vec3 &position,
+                                     const glm::quat &rotation, const glm::vec3 &scale)
+{
+  // Update relies on every parent being added before its children.
+  ASSERT(parent == NoParent || parent < GetCount());
+  unsigned int node = GetCount();
+  unsigned int depth = parent == NoParent ? 0 : m_depths[parent] + 1;
+  m_parents.push_back(parent);
+  m_positions.push_back(position);
+  m_rotations.push_back(rotation);
+  m_scales.push_back(scale);
+  m_worldMatrices.push_back(glm::mat4(1.0f));
+  m_dirty.push_back(1);
+  m_changed.push_back(0);
+  m_depths.push_back(depth);
+  if (m_levels.size() <= depth)
+    m_levels.resize(depth + 1);
+  m_levels[depth].push_back(node);
+  return node;
+}
+
+void TransformHierarchy::SetPosition(unsigned int node, const glm::vec3 &position)
+{
+  if (m_positions[node] == position)
+    return;
+  m_positions[node] = position;
+  m_dirty[node] = 1;
+}
+
+void TransformHierarchy::SetRotation(unsigned int node, const glm::quat &rotation)
+{
+  if (m_rotations[node] == rotation)
+    return;
+  m_rotations[node] = rotation;
+  m_dirty[node] = 1;
+}
+
+void TransformHierarchy::SetScale(unsigned int node, const glm::vec3 &scale)
+{
+  if (m_scales[node] == scale)
+    return;
+  m_scales[node] = scale;
+  m_dirty[node] = 1;
+}
+
+bool TransformHierarchy::UpdateNode(unsigned int node)
+{
+  unsigned int parent = m_parents[node];
+  bool parentChanged = parent != NoParent && m_changed[parent];
+  if (!m_dirty[node] && !parentChanged)
+  {
+    m_changed[node] = 0;
+    return false;
+  }
+
+  // translate * rotate * scale without going through three matrix multiplies.
+  glm::mat4 local = glm::mat4_cast(m_rotations[node]);
+  const glm::vec3 &scale = m_scales[node];
+  local[0] = local[0] * scale.x;
+  local[1] = local[1] * scale.y;
+  local[2] = local[2] * scale.z;
+  local[3] = glm::vec4(m_positions[node], 1.0f);
+
+  m_worldMatrices[node] = parent == NoParent ? local : m_worldMatrices[parent] * local;
+  m_dirty[node] = 0;
+  m_changed[node] = 1;
+  return true;
+}
+
+unsigned int TransformHierarchy::Update(ThreadPool *pool)
+{
+  unsigned int count = GetCount();
+  if (!pool || pool->GetConcurrency() == 1 || count < ParallelUpdateThreshold)
+  {
+    unsigned int updated = 0;
+    for (unsigned int node = 0; node < count; node++)
+      updated += UpdateNode(node);
+    return updated;
+  }
+
+  // nodes on one level never depend on each other, so each level is split
+  // across the pool once the level above it is complete.
+  std::atomic<unsigned int> updated{0};
+  for (const std::vector<unsigned int> &level : m_levels)
+  {
+    pool->ParallelFor((unsigned int)level.size(), ParallelUpdateChunk,
+                      [this, &level, &updated](unsigned int begin, unsigned int end)
+                      {
+                        unsigned int local = 0;
+                        for (unsigned int i = begin; i < end; i++)
+                          local += UpdateNode(level[i]);
+                        updated.fetch_add(local, std::memory_order_relaxed);
+                      });
+  }
+  return updated.load();
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+class ThreadPool;
+
+// Scene transforms stored as parallel arrays. A node is always added after
+// its parent, so walking the arrays in order visits parents first and world
+// matrices can be rebuilt in a single pass. Only nodes that were changed, or
+// whose parent was rebuilt this update, are recomputed.
+class TransformHierarchy
+{
+public:
+  static constexpr unsigned int NoParent = 0xFFFFFFFF;
+
+private:
+  std::vector<unsigned int> m_parents;
+  std::vector<glm::vec3> m_positions;
+  std::vector<glm::quat> m_rotations;
+  std::vector<glm::vec3> m_scales;
+  std::vector<glm::mat4> m_worldMatrices;
+  // set by the setters, cleared by Update.
+  std::vector<unsigned char> m_dirty;
+  // set when the world matrix was rebuilt in the last Update.
+  std::vector<unsigned char> m_changed;
+  // node indices grouped by depth, each level only depends on the one above.
+  std::vector<std::vector<unsigned int>> m_levels;
+  std::vector<unsigned int> m_depths;
+
+public:
+  // parent must be NoParent or a node that was already added.
+  unsigned int Add(unsigned int parent = NoParent,
+                   const glm::vec3 &position = glm::vec3(0.0f),
+                   const glm::quat &rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f),
+                   const glm::vec3 &scale = glm::vec3(1.0f));
+
+  void SetPosition(unsigned int node, const glm::vec3 &position);
+  void SetRotation(unsigned int node, const glm::quat &rotation);
+  void SetScale(unsigned int node, const glm::vec3 &scale);
+
+  // rebuilds world matrices of dirty subtrees, spreading the work over the
+  // pool for large hierarchies. Returns how many matrices were recomputed.
+  unsigned int Update(ThreadPool *pool = nullptr);
+
+  inline const glm::vec3 &GetPosition(unsigned int node) const { return m_positions[node]; }
+  inline const glm::quat &GetRotation(unsigned int node) const { return m_rotations[node]; }
+  inline const glm::vec3 &GetScale(unsigned int node) const { return m_scales[node]; }
+  inline unsigned int GetParent(unsigned int node) const { return m_parents[node]; }
+  inline const glm::mat4 &GetWorldMatrix(unsigned int node) const { return m_worldMatrices[node]; }
+  inline unsigned int GetCount() const { return (unsigned int)m_parents.size(); }
+
+private:
+  bool UpdateNode(unsigned int node);
+};
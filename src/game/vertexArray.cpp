@@ -1,3 +1,4 @@
+#include "gpuMemory.h"
 #include "vertexArray.h"
 #include "vertexBufferLayout.h"
 #include "renderer.h"
@@ -12,10 +13,39 @@ VertexArray::~VertexArray()
 	GLCall(glDeleteVertexArrays(1, &m_renderID));
 }
 
+VertexArray::VertexArray(VertexArray &&other) noexcept
+	: m_renderID(other.m_renderID)
+{
+	other.m_renderID = 0;
+}
+
+VertexArray &VertexArray::operator=(VertexArray &&other) noexcept
+{
+	if (this != &other)
+	{
+		GLCall(glDeleteVertexArrays(1, &m_renderID));
+		m_renderID = other.m_renderID;
+		other.m_renderID = 0;
+	}
+	return *this;
+}
+
 void VertexArray::AddBuffer(const VertexBuffer &vb, const VertexBufferLayout &layout)
 {
 	Bind();
 	vb.Bind();
+	SetLayout(layout);
+}
+
+void VertexArray::AddBuffer(const BufferArena &arena, const VertexBufferLayout &layout)
+{
+	Bind();
+	arena.Bind(GL_ARRAY_BUFFER);
+	SetLayout(layout);
+}
+
+void VertexArray::SetLayout(const VertexBufferLayout &layout)
+{
 	const auto &elements = layout.GetElements();
 	unsigned int offset = 0;
 	for (unsigned int i = 0; i < elements.size(); i++)
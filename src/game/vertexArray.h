@@ -1,6 +1,7 @@
 #pragma once
 #include "vertexBuffer.h"
 
+class BufferArena;
 class VertexBufferLayout;
 
 class VertexArray
@@ -12,7 +13,18 @@ public:
   VertexArray();
   ~VertexArray();
 
+  VertexArray(const VertexArray &) = delete;
+  VertexArray &operator=(const VertexArray &) = delete;
+  VertexArray(VertexArray &&other) noexcept;
+  VertexArray &operator=(VertexArray &&other) noexcept;
+
   void AddBuffer(const VertexBuffer& vb, const VertexBufferLayout& layout);
+  // attributes start at offset 0 of the arena, meshes in it are addressed
+  // with a base vertex.
+  void AddBuffer(const BufferArena& arena, const VertexBufferLayout& layout);
   void Bind() const;
   void Unbind() const;
+
+private:
+  void SetLayout(const VertexBufferLayout& layout);
 };
@@ -2,16 +2,48 @@
 #include "renderer.h"
 #include <GL/glew.h>
 
-VertexBuffer::VertexBuffer(const void *data, unsigned int size) {
+VertexBuffer::VertexBuffer(const void *data, unsigned int size)
+    : m_size(size) {
   GLCall(glGenBuffers(1, &m_rendererID));
   GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_rendererID));
   GLCall(glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW));
 }
 
+VertexBuffer::VertexBuffer(unsigned int size) : m_size(size) {
+  GLCall(glGenBuffers(1, &m_rendererID));
+  GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_rendererID));
+  GLCall(glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW));
+}
+
 VertexBuffer::~VertexBuffer() { GLCall(glDeleteBuffers(1, &m_rendererID)); }
 
+VertexBuffer::VertexBuffer(VertexBuffer &&other) noexcept
+    : m_rendererID(other.m_rendererID), m_size(other.m_size) {
+  other.m_rendererID = 0;
+  other.m_size = 0;
+}
+
+VertexBuffer &VertexBuffer::operator=(VertexBuffer &&other) noexcept {
+  if (this != &other) {
+    GLCall(glDeleteBuffers(1, &m_rendererID));
+    m_rendererID = other.m_rendererID;
+    m_size = other.m_size;
+    other.m_rendererID = 0;
+    other.m_size = 0;
+  }
+  return *this;
+}
+
 void VertexBuffer::Bind() const {
   GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_rendererID));
 }
 
 void VertexBuffer::Unbind() const { GLCall(glBindBuffer(GL_ARRAY_BUFFER, 0)); }
+
+void VertexBuffer::SetData(const void *data, unsigned int size) {
+  ASSERT(size <= m_size);
+  GLCall(glBindBuffer(GL_ARRAY_BUFFER, m_rendererID));
+  // orphan the old storage so the driver does not stall on a draw still using it.
+  GLCall(glBufferData(GL_ARRAY_BUFFER, m_size, nullptr, GL_DYNAMIC_DRAW));
+  GLCall(glBufferSubData(GL_ARRAY_BUFFER, 0, size, data));
+}
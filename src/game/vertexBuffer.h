@@ -3,11 +3,21 @@
 class VertexBuffer {
 private:
   unsigned int m_rendererID;
+  unsigned int m_size;
 
 public:
   VertexBuffer(const void *data, unsigned int size);
+  // dynamic buffer of size bytes, filled each frame with SetData.
+  VertexBuffer(unsigned int size);
   ~VertexBuffer();
 
+  // owns the GL buffer, so it can be moved but never copied.
+  VertexBuffer(const VertexBuffer &) = delete;
+  VertexBuffer &operator=(const VertexBuffer &) = delete;
+  VertexBuffer(VertexBuffer &&other) noexcept;
+  VertexBuffer &operator=(VertexBuffer &&other) noexcept;
+
   void Bind() const;
   void Unbind() const;
+  void SetData(const void *data, unsigned int size);
 };
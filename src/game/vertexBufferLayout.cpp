@@ -12,12 +12,12 @@
   {
  	VertexBufferElement element = {GL_UNSIGNED_INT, count, GL_FALSE};
     m_elements.push_back(element);
-    m_stride = count * element.GetSizeOfType(GL_UNSIGNED_INT);
+    m_stride += count * element.GetSizeOfType(GL_UNSIGNED_INT);
   }
   template <>
   void VertexBufferLayout::Push<unsigned char>(unsigned int  count)
   {
     VertexBufferElement element = {GL_UNSIGNED_BYTE, count, GL_TRUE};
     m_elements.push_back(element);
-    m_stride = count * element.GetSizeOfType(GL_UNSIGNED_BYTE);
+    m_stride += count * element.GetSizeOfType(GL_UNSIGNED_BYTE);
   }
\ No newline at end of file
@@ -34,8 +34,30 @@ public:
       : m_stride(0) {}
 
   template <typename T>
-  void Push(unsigned int count) { ASSERT(false); }
+  void Push(unsigned int) { ASSERT(false); }
 
-  inline const std::vector<VertexBufferElement> GetElements() const { return m_elements; }
+  inline const std::vector<VertexBufferElement> &GetElements() const { return m_elements; }
   inline unsigned int GetStride() const { return m_stride; }
+
+  bool operator==(const VertexBufferLayout &other) const
+  {
+    if (m_stride != other.m_stride || m_elements.size() != other.m_elements.size())
+      return false;
+    for (unsigned int i = 0; i < m_elements.size(); i++)
+    {
+      const VertexBufferElement &a = m_elements[i], &b = other.m_elements[i];
+      if (a.type != b.type || a.count != b.count || a.normalized != b.normalized)
+        return false;
+    }
+    return true;
+  }
 };
+
+// defined in vertexBufferLayout.cpp, declared here so callers do not
+// instantiate the generic template instead.
+template <>
+void VertexBufferLayout::Push<float>(unsigned int count);
+template <>
+void VertexBufferLayout::Push<unsigned int>(unsigned int count);
+template <>
+void VertexBufferLayout::Push<unsigned char>(unsigned int count);